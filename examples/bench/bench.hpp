@@ -0,0 +1,144 @@
+/**********************************************************************
+    * bench.hpp -- the harness of the ForSyDe benchmark suite         *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Measuring the simulation speed of synthetic networks   *
+    *          of ForSyDe processes.                                  *
+    *                                                                 *
+    * Usage:   Benchmark suite                                        *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <forsyde.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace sc_core;
+using namespace ForSyDe;
+
+typedef std::chrono::steady_clock bench_clock;
+
+//! The base class of the synthetic networks
+/*! A network is the top module of a benchmark. It builds its processes
+ * in the constructor and counts the tokens reaching its sinks, from
+ * which it computes the number of firings and transferred tokens.
+ */
+class bench_network : public sc_module
+{
+public:
+    bench_network(sc_module_name _name) : sc_module(_name), delivered(0) {}
+
+    //! The number of tokens consumed by the sinks
+    unsigned long long delivered;
+
+    //! The number of tokens the sinks are expected to consume
+    virtual unsigned long long expected() const = 0;
+
+    //! The total number of process firings
+    virtual unsigned long long firings() const = 0;
+
+    //! The total number of tokens written to the signals
+    virtual unsigned long long tokens() const = 0;
+
+    //! The host time when the simulation started
+    bench_clock::time_point sim_start;
+
+private:
+    void start_of_simulation()
+    {
+        sim_start = bench_clock::now();
+    }
+};
+
+//! A benchmark case of the suite
+struct bench_case
+{
+    std::string moc;        ///< the MoC of the network
+    std::string network;    ///< the topology of the network
+    unsigned size;          ///< the number of processes or branches
+    unsigned long long toks;///< the number of tokens of the sources
+    double param;           ///< a topology-specific parameter
+    //! Constructs the network
+    std::function<bench_network*(const bench_case&)> build;
+
+    //! The identifier of the case used for filtering
+    std::string id() const
+    {
+        std::stringstream ss;
+        ss << moc << "/" << network << "/" << size;
+        return ss.str();
+    }
+};
+
+//! Runs a benchmark case in the current process and prints its results
+inline void run_case(const bench_case& c, std::ostream& os)
+{
+    auto t0 = bench_clock::now();
+    bench_network* net = c.build(c);
+    sc_start();
+    auto t1 = bench_clock::now();
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    double elab = std::chrono::duration<double>(net->sim_start - t0).count();
+    double sim = std::chrono::duration<double>(t1 - net->sim_start).count();
+
+    os << "{\"moc\": \"" << c.moc << "\", \"network\": \"" << c.network << "\""
+       << ", \"size\": " << c.size << ", \"toks\": " << c.toks
+       << ", \"param\": " << c.param
+       << ", \"ok\": " << (net->delivered == net->expected() ? "true" : "false")
+       << ", \"firings\": " << net->firings()
+       << ", \"tokens\": " << net->tokens()
+       << ", \"elab_s\": " << elab << ", \"sim_s\": " << sim
+       << ", \"firings_per_s\": " << net->firings() / sim
+       << ", \"tokens_per_s\": " << net->tokens() / sim
+       << ", \"peak_rss_kb\": " << ru.ru_maxrss << "}" << std::endl;
+}
+
+//! Runs each benchmark case in a separate child process
+/*! A SystemC model can be elaborated only once per process, hence each
+ * case is forked from the harness before any module is constructed.
+ * The results are printed as one JSON object per line. A case whose
+ * child process fails is reported with "ok": false.
+ */
+inline int run_suite(const std::vector<bench_case>& cases,
+                     const std::string& filter, std::ostream& os)
+{
+    int failed = 0;
+    for (auto it=cases.begin();it!=cases.end();it++)
+    {
+        if (it->id().find(filter) == std::string::npos) continue;
+        os.flush();
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            run_case(*it, os);
+            os.flush();
+            _exit(0);
+        }
+        int status = -1;
+        if (pid > 0) waitpid(pid, &status, 0);
+        if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            os << "{\"moc\": \"" << it->moc << "\", \"network\": \"" << it->network << "\""
+               << ", \"size\": " << it->size << ", \"toks\": " << it->toks
+               << ", \"param\": " << it->param << ", \"ok\": false}" << std::endl;
+            failed++;
+        }
+    }
+    return failed;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/**********************************************************************
+    * dde_bench.hpp -- synthetic networks in the DDE MoC              *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Chains and zips of DDE event streams.                  *
+    *                                                                 *
+    * Usage:   Benchmark suite                                        *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef DDE_BENCH_HPP
+#define DDE_BENCH_HPP
+
+#include "bench.hpp"
+#include <set>
+
+//! Creates a DDE source of periodic events with increasing values
+inline DDE::source<int>* make_event_stream(const std::string& name,
+    const sc_time& period, unsigned long long toks, DDE::signal<int>& out)
+{
+    return DDE::make_source(name,
+        [period](ttn_event<int>& out, const ttn_event<int>& prev)
+        {
+            out = ttn_event<int>(get_value(prev).from_abst_ext(0) + 1,
+                                 get_time(prev) + period);
+        }, ttn_event<int>(abst_ext<int>(0), SC_ZERO_TIME), toks, out);
+}
+
+//! A stream of events processed by a chain of size comb processes
+/*! The source produces param events per microsecond of simulated time.
+ */
+class dde_chain : public bench_network
+{
+public:
+    dde_chain(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks)
+    {
+        for (unsigned i=0; i<=n; i++)
+            sigs.push_back(new DDE::signal<int>);
+        make_event_stream("src", sc_time(1.0/c.param, SC_US), toks, *sigs[0]);
+        for (unsigned i=0; i<n; i++)
+            DDE::make_comb("comb" + std::to_string(i),
+                [](abst_ext<int>& out, const int& inp) {out = inp + 1;},
+                *sigs[i+1], *sigs[i]);
+        DDE::make_sink("snk", [this](const ttn_event<int>&) {delivered++;}, *sigs[n]);
+    }
+
+    unsigned long long expected() const {return toks;}
+    unsigned long long firings() const {return delivered * (n+2);}
+    unsigned long long tokens() const {return delivered * (n+1);}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+    std::vector<DDE::signal<int>*> sigs;
+};
+
+//! Two event streams of different densities zipped into a sink
+/*! The first stream has one event per microsecond and the second one
+ * param times as many. The sink receives an event for each distinct
+ * time tag of the two streams.
+ */
+class dde_zip : public bench_network
+{
+public:
+    typedef std::tuple<abst_ext<int>,abst_ext<int>> zipped;
+
+    dde_zip(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), toks(c.toks)
+    {
+        auto a = new DDE::signal<int>;
+        auto b = new DDE::signal<int>;
+        auto z = new DDE::signal<zipped>;
+        sc_time pa(1, SC_US), pb(1.0/c.param, SC_US);
+        make_event_stream("src1", pa, toks, *a);
+        make_event_stream("src2", pb, toks, *b);
+        DDE::make_zip("zip", *z, *a, *b);
+        DDE::make_sink("snk", [this](const ttn_event<zipped>&) {delivered++;}, *z);
+        // The distinct time tags up to the end of the shorter stream
+        sc_time end = std::min(pa, pb) * (double)(toks-1);
+        std::set<sc_time> tags;
+        for (unsigned long long i=0; i<toks; i++)
+        {
+            if (pa*(double)i <= end) tags.insert(pa*(double)i);
+            if (pb*(double)i <= end) tags.insert(pb*(double)i);
+        }
+        out_toks = tags.size();
+    }
+
+    unsigned long long expected() const {return out_toks;}
+    unsigned long long firings() const {return 2 * toks + 2 * delivered;}
+    unsigned long long tokens() const {return 2 * toks + delivered;}
+
+private:
+    unsigned long long toks;
+    unsigned long long out_toks;
+};
+
+#endif
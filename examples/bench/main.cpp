@@ -0,0 +1,50 @@
+/**********************************************************************
+    * main.cpp -- the main file of the ForSyDe benchmark suite        *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Measuring the simulation speed of synthetic networks   *
+    *          in each MoC to track regressions across versions.      *
+    *                                                                 *
+    * Usage:   run [filter] [tokens]                                  *
+    *          Runs the cases whose identifier (MoC/network/size)     *
+    *          contains filter, with the given number of tokens per   *
+    *          source, and prints one JSON object per case and line.  *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#include "sy_bench.hpp"
+#include "sdf_bench.hpp"
+#include "dde_bench.hpp"
+#include "ut_bench.hpp"
+#include <cstdlib>
+
+template <class N>
+bench_network* build(const bench_case& c)
+{
+    return new N("top", c);
+}
+
+int sc_main(int argc, char **argv)
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    unsigned long long toks = argc > 2 ? std::strtoull(argv[2], NULL, 10) : 10000;
+
+    std::vector<bench_case> cases;
+    for (unsigned n : {1, 16, 256})
+    {
+        cases.push_back({"SY", "chain", n, toks, 0, build<sy_chain>});
+        cases.push_back({"SY", "tree", n, toks, 0, build<sy_tree>});
+        cases.push_back({"SY", "fanout", n, toks, 0, build<sy_fanout>});
+        cases.push_back({"SDF", "chain", n, toks, 4, build<sdf_chain>});
+        cases.push_back({"DDE", "chain", n, toks, 1, build<dde_chain>});
+        cases.push_back({"UT", "mealy_chain", n, toks, 4, build<ut_mealy_chain>});
+    }
+    for (unsigned n : {1, 64})
+        cases.push_back({"SDF", "zip", n, toks, 0, build<sdf_zip>});
+    for (double density : {0.1, 1.0, 10.0})
+        cases.push_back({"DDE", "zip", 2, toks, density, build<dde_zip>});
+
+    return run_suite(cases, filter, std::cout);
+}
@@ -0,0 +1,96 @@
+/**********************************************************************
+    * sdf_bench.hpp -- synthetic networks in the SDF MoC              *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Multi-rate chains and zips of SDF actors.              *
+    *                                                                 *
+    * Usage:   Benchmark suite                                        *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SDF_BENCH_HPP
+#define SDF_BENCH_HPP
+
+#include "bench.hpp"
+
+//! A multi-rate chain of size actors between a source and a sink
+/*! The actors alternate between up-sampling by a factor param and
+ * down-sampling by the same factor.
+ */
+class sdf_chain : public bench_network
+{
+public:
+    sdf_chain(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks), rate(c.param)
+    {
+        for (unsigned i=0; i<=n; i++)
+            sigs.push_back(new SDF::signal<int>);
+        SDF::make_source("src", [](int& out, const int& st) {out = st + 1;},
+                         0, toks, *sigs[0]);
+        unsigned long long t = toks;
+        tokens_per_iter = t;
+        firings_per_iter = t;
+        for (unsigned i=0; i<n; i++)
+        {
+            bool up = i % 2 == 0;
+            unsigned itoks = up ? 1 : rate;
+            unsigned otoks = up ? rate : 1;
+            SDF::make_comb("comb" + std::to_string(i),
+                [](std::vector<int>& out, const std::vector<int>& inp)
+                {
+                    for (size_t j=0; j<out.size(); j++)
+                        out[j] = inp[j % inp.size()] + 1;
+                }, otoks, itoks, *sigs[i+1], *sigs[i]);
+            firings_per_iter += t / itoks;
+            t = t / itoks * otoks;
+            tokens_per_iter += t;
+        }
+        out_toks = t;
+        firings_per_iter += t;
+        SDF::make_sink("snk", [this](const int&) {delivered++;}, *sigs[n]);
+    }
+
+    unsigned long long expected() const {return out_toks;}
+    unsigned long long firings() const {return firings_per_iter;}
+    unsigned long long tokens() const {return tokens_per_iter;}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+    unsigned rate;
+    unsigned long long out_toks, firings_per_iter, tokens_per_iter;
+    std::vector<SDF::signal<int>*> sigs;
+};
+
+//! Two sources zipped in blocks of size tokens into a sink
+class sdf_zip : public bench_network
+{
+public:
+    typedef std::tuple<std::vector<int>,std::vector<int>> zipped;
+
+    sdf_zip(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks)
+    {
+        auto a = new SDF::signal<int>;
+        auto b = new SDF::signal<int>;
+        auto z = new SDF::signal<zipped>;
+        SDF::make_source("src1", [](int& out, const int& st) {out = st + 1;},
+                         0, toks * n, *a);
+        SDF::make_source("src2", [](int& out, const int& st) {out = st - 1;},
+                         0, toks * n, *b);
+        SDF::make_zip("zip", n, n, *z, *a, *b);
+        SDF::make_sink("snk", [this](const zipped&) {delivered++;}, *z);
+    }
+
+    unsigned long long expected() const {return toks;}
+    unsigned long long firings() const {return 2 * delivered * n + 2 * delivered;}
+    unsigned long long tokens() const {return 2 * delivered * n + delivered;}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**********************************************************************
+    * sy_bench.hpp -- synthetic networks in the SY MoC                *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Chains, trees and fan-outs of SY processes.            *
+    *                                                                 *
+    * Usage:   Benchmark suite                                        *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SY_BENCH_HPP
+#define SY_BENCH_HPP
+
+#include "bench.hpp"
+
+//! A source followed by a chain of size comb processes and a sink
+class sy_chain : public bench_network
+{
+public:
+    sy_chain(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks)
+    {
+        for (unsigned i=0; i<=n; i++)
+            sigs.push_back(new SY::signal<int>);
+        SY::make_source("src", [](abst_ext<int>& out, const abst_ext<int>& st)
+            {
+                out = st.from_abst_ext(0) + 1;
+            }, abst_ext<int>(0), toks, *sigs[0]);
+        for (unsigned i=0; i<n; i++)
+            SY::make_comb("comb" + std::to_string(i),
+                [](abst_ext<int>& out, const abst_ext<int>& inp)
+                {
+                    out = inp.from_abst_ext(0) + 1;
+                }, *sigs[i+1], *sigs[i]);
+        SY::make_sink("snk", [this](const abst_ext<int>&) {delivered++;}, *sigs[n]);
+    }
+
+    unsigned long long expected() const {return toks;}
+    unsigned long long firings() const {return delivered * (n+2);}
+    unsigned long long tokens() const {return delivered * (n+1);}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+    std::vector<SY::signal<int>*> sigs;
+};
+
+//! A binary tree of comb2 processes reducing size sources to a sink
+class sy_tree : public bench_network
+{
+public:
+    sy_tree(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks)
+    {
+        std::vector<SY::signal<int>*> level;
+        for (unsigned i=0; i<n; i++)
+        {
+            level.push_back(new SY::signal<int>);
+            SY::make_source("src" + std::to_string(i),
+                [](abst_ext<int>& out, const abst_ext<int>& st)
+                {
+                    out = st.from_abst_ext(0) + 1;
+                }, abst_ext<int>(0), toks, *level.back());
+        }
+        unsigned id = 0;
+        while (level.size() > 1)
+        {
+            std::vector<SY::signal<int>*> next;
+            for (size_t i=0; i+1<level.size(); i+=2)
+            {
+                next.push_back(new SY::signal<int>);
+                SY::make_comb2("add" + std::to_string(id++),
+                    [](abst_ext<int>& out, const abst_ext<int>& a, const abst_ext<int>& b)
+                    {
+                        out = a.from_abst_ext(0) + b.from_abst_ext(0);
+                    }, *next.back(), *level[i], *level[i+1]);
+            }
+            if (level.size() % 2) next.push_back(level.back());
+            level = next;
+        }
+        SY::make_sink("snk", [this](const abst_ext<int>&) {delivered++;}, *level[0]);
+    }
+
+    unsigned long long expected() const {return toks;}
+    unsigned long long firings() const {return delivered * 2 * n;}
+    unsigned long long tokens() const {return delivered * (2*n-1);}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+};
+
+//! A source whose output port drives size comb processes, each with a sink
+class sy_fanout : public bench_network
+{
+public:
+    sy_fanout(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks)
+    {
+        auto src = new SY::source<int>("src",
+            [](abst_ext<int>& out, const abst_ext<int>& st)
+            {
+                out = st.from_abst_ext(0) + 1;
+            }, abst_ext<int>(0), toks);
+        for (unsigned i=0; i<n; i++)
+        {
+            auto branch = new SY::signal<int>;
+            auto result = new SY::signal<int>;
+            src->oport1(*branch);
+            SY::make_comb("comb" + std::to_string(i),
+                [](abst_ext<int>& out, const abst_ext<int>& inp)
+                {
+                    out = inp.from_abst_ext(0) * 2;
+                }, *result, *branch);
+            SY::make_sink("snk" + std::to_string(i),
+                [this](const abst_ext<int>&) {delivered++;}, *result);
+        }
+    }
+
+    unsigned long long expected() const {return toks * n;}
+    unsigned long long firings() const {return delivered / n * (2*n+1);}
+    unsigned long long tokens() const {return delivered * 2;}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+};
+
+#endif
@@ -0,0 +1,59 @@
+/**********************************************************************
+    * ut_bench.hpp -- synthetic networks in the UT MoC                *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Chains of UT state machines.                           *
+    *                                                                 *
+    * Usage:   Benchmark suite                                        *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef UT_BENCH_HPP
+#define UT_BENCH_HPP
+
+#include "bench.hpp"
+
+//! A chain of size mealy processes between a source and a sink
+/*! Each mealy process consumes param tokens in each firing, accumulates
+ * them in its state and forwards them to its output.
+ */
+class ut_mealy_chain : public bench_network
+{
+public:
+    ut_mealy_chain(sc_module_name _name, const bench_case& c)
+        : bench_network(_name), n(c.size), toks(c.toks), rate(c.param)
+    {
+        for (unsigned i=0; i<=n; i++)
+            sigs.push_back(new UT::signal<int>);
+        UT::make_source("src", [](int& out, const int& st) {out = st + 1;},
+                        0, toks * rate, *sigs[0]);
+        unsigned r = rate;
+        for (unsigned i=0; i<n; i++)
+            UT::make_mealy("mealy" + std::to_string(i),
+                [r](unsigned int& itoks, const int&) {itoks = r;},
+                [](int& ns, const int& st, const std::vector<int>& inp)
+                {
+                    ns = st;
+                    for (auto it=inp.begin();it!=inp.end();it++) ns += *it;
+                },
+                [](std::vector<int>& out, const int& st, const std::vector<int>& inp)
+                {
+                    out = inp;
+                }, 0, *sigs[i+1], *sigs[i]);
+        UT::make_sink("snk", [this](const int&) {delivered++;}, *sigs[n]);
+    }
+
+    unsigned long long expected() const {return toks * rate;}
+    unsigned long long firings() const {return 2 * delivered + delivered / rate * n;}
+    unsigned long long tokens() const {return delivered * (n+1);}
+
+private:
+    unsigned n;
+    unsigned long long toks;
+    unsigned rate;
+    std::vector<UT::signal<int>*> sigs;
+};
+
+#endif
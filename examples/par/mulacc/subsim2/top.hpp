@@ -30,7 +30,7 @@ SC_MODULE(top)
         
         make_source("siggen1", siggen_func, abst_ext<int>(1), 10, srcb);
         
-        make_sender<int>("sender1", partner_rank, 1, srcb);
+        make_sender<int>("sender1", partner_rank, 1, srcb, 10);
         
         auto receiver1 = new receiver<int>("receiver1", partner_rank, 0);
         receiver1->oport1(result);
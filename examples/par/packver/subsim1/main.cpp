@@ -0,0 +1,30 @@
+/**********************************************************************
+    * main.cpp -- the main file and testbench for the packet verifier *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Demonstration of a parallel DDE system.                *
+    *                                                                 *
+    * Usage:   Parallel Packet Verifier example                       *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#include "top.hpp"
+
+int sc_main(int argc, char **argv)
+{
+    MPI_Init (&argc, &argv);
+    
+    top top1("top1");
+
+    sc_start(100,SC_MS);
+    
+    // Lets the senders release the other sub-simulation
+    sc_stop();
+    
+    MPI_Finalize();
+        
+    return 0;
+}
+
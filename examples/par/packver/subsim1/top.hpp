@@ -0,0 +1,60 @@
+/**********************************************************************
+    * top.hpp -- the top module and testbench for the packet verifier *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Demonstration of a parallel DDE system.                *
+    *                                                                 *
+    * Usage:   Parallel Packet Verifier example                       *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#include "splitter.hpp"
+#include <iostream>
+
+using namespace ForSyDe;
+
+SC_MODULE(top)
+{
+    DDE::signal<int> si, s1, s2;
+    DDE::signal<char> sp1, sf;
+    
+    SC_CTOR(top)
+    {
+        int world_rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+        int partner_rank = (world_rank + 1) % 2;
+        
+        DDE::make_vsource("inputs", {4, 8, -3}, 
+            {sc_time(10,SC_MS), sc_time(40,SC_MS), sc_time(60,SC_MS)}, si
+        );
+        
+        DDE::make_receiver<char>("receiver1", partner_rank, 2, sf);
+        
+        auto splitter1 = new splitter("splitter1");
+        splitter1->iport1(sf);
+        splitter1->iport2(si);
+        splitter1->oport1(s1);
+        splitter1->oport2(s2);
+        
+        DDE::make_comb("pv1", pv_func, sp1, s1);
+        
+        DDE::make_sender("sender1", partner_rank, 0, s2);
+        
+        DDE::make_sender("sender2", partner_rank, 1, sp1);
+    }
+    
+    static void pv_func(abst_ext<char>& out, const int& inp)
+    {
+        out = abst_ext<char>(inp>=0 ? 'V' : 'F');
+    }
+    
+#ifdef FORSYDE_INTROSPECTION
+    void start_of_simulation()
+    {
+        ForSyDe::XMLExport dumper("subsim1/gen/");
+        dumper.traverse(this);
+    }
+#endif
+};
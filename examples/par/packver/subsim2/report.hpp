@@ -0,0 +1,29 @@
+/**********************************************************************
+    * report.hpp -- the report process                                *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Demonstration of a simple DDE system.                  *
+    *                                                                 *
+    * Usage:   Packet Verifier example                                *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+
+#ifndef REPORT_HPP
+#define REPORT_HPP
+
+#include <forsyde.hpp>
+#include <iostream>
+
+using namespace ForSyDe;
+
+void report_func(ttn_event<char> inp1)
+{
+#pragma ForSyDe begin report_func
+    std::cout << "output value: " << inp1 << std::endl;
+#pragma ForSyDe end
+}
+
+#endif
@@ -0,0 +1,67 @@
+/**********************************************************************
+    * top.hpp -- the top module and testbench for the packet verifier *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Demonstration of a parallel DDE system.                *
+    *                                                                 *
+    * Usage:   Parallel Packet Verifier example                       *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#include "report.hpp"
+#include <iostream>
+
+using namespace ForSyDe;
+
+SC_MODULE(top)
+{
+    DDE::signal<int> s2;
+    DDE::signal<char> sp1, sp2, so1, so2, sf;
+    
+    SC_CTOR(top)
+    {
+        int world_rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+        int partner_rank = (world_rank + 1) % 2;
+        
+        DDE::make_receiver<int>("receiver1", partner_rank, 0, s2);
+        
+        DDE::make_receiver<char>("receiver2", partner_rank, 1, sp1);
+        
+        DDE::make_comb("pv2", pv_func, sp2, s2);
+        
+        auto merge1 = DDE::make_comb2("merge1", merge_func, so1, sp1, sp2);
+        merge1->oport1(so2);
+        
+        DDE::make_delay("delay1", abst_ext<char>(), sc_time(15,SC_MS),
+            sf, so2
+        );
+        
+        // The delay separates the events from the receivers and to the sender
+        DDE::make_sender("sender1", partner_rank, 2, sf, sc_time(15,SC_MS));
+        
+        DDE::make_sink("report1", report_func, so1);
+    }
+    
+    static void pv_func(abst_ext<char>& out, const int& inp)
+    {
+        out = abst_ext<char>(inp>=0 ? 'V' : 'F');
+    }
+    
+    static void merge_func(abst_ext<char>& out, const abst_ext<char>& inp1, const abst_ext<char>& inp2)
+    {
+        out = unsafe_from_abst_ext(inp1)=='F' || unsafe_from_abst_ext(inp2)=='F'?
+            abst_ext<char>('F'):
+            abst_ext<char>('V');
+    }
+    
+#ifdef FORSYDE_INTROSPECTION
+    void start_of_simulation()
+    {
+        ForSyDe::XMLExport dumper("subsim2/gen/");
+        dumper.traverse(this);
+    }
+#endif
+};
@@ -67,6 +67,10 @@
 #include "forsyde/prettyprint.hpp"
 
 // include the main SystemC library
+#ifdef FORSYDE_PARALLEL_SIM
+// the partitioner spawns the threads which link the partitions
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
 #include <systemc>
 
 #ifdef FORSYDE_INTROSPECTION
@@ -105,6 +109,15 @@
 
 #ifdef FORSYDE_PARALLEL_SIM
 #include "forsyde/parallel_sim_helpers.hpp"
+#include "forsyde/partitioner.hpp"
+#endif
+
+#ifdef FORSYDE_SHM_SIM
+#include "forsyde/shm_sim_helpers.hpp"
+#endif
+
+#ifdef FORSYDE_BATCH_SIM
+#include "forsyde/batch_sim.hpp"
 #endif
 
 #ifdef FORSYDE_COSIMULATION_WRAPPERS
@@ -30,18 +30,63 @@
 
 #include <sstream>
 #include <fstream>
+#include <memory>
+#include <functional>
+#include <vector>
+#include <type_traits>
+#ifdef FORSYDE_COROUTINES
+#include <coroutine>
+#endif
 
+#include "ring_buffer.hpp"
+#include "profiler.hpp"
+#include "tracer.hpp"
+#ifdef FORSYDE_PARALLEL_SIM
+#include "mpi_message.hpp"
+#endif
 
 namespace ForSyDe
 {
 
 using namespace sc_core;
 
+namespace SDF
+{
+class static_scheduler;
+}
+
+namespace SY
+{
+class comb_fusion;
+}
+
+class partitioner;
+
+//! Checks if a port can broadcast a token to all of its bound channels
+template<typename If, typename=void>
+struct can_broadcast : std::false_type {};
+
+template<typename If>
+struct can_broadcast<If, std::void_t<decltype(&If::broadcast)>> : std::true_type {};
+
 // Auxilliary Macro definitions
 template<typename T, typename If>
 void inline write_multiport(If& PORT, const T& VAL)  {
-    for (int WMPi=0;WMPi<PORT.size();WMPi++)
-        PORT[WMPi]->write(VAL);
+    if constexpr (can_broadcast<If>::value)
+        PORT.broadcast(VAL);
+    else
+        for (int WMPi=0;WMPi<PORT.size();WMPi++)
+            PORT[WMPi]->write(VAL);
+}
+
+//! Moves a value into the last channel bound to a port and copies it to the others
+template<typename T, typename If, typename=std::enable_if_t<!std::is_lvalue_reference<T>::value>>
+void inline write_multiport(If& PORT, T&& VAL)  {
+    if constexpr (can_broadcast<If>::value)
+        PORT.write_move(std::move(VAL));
+    else
+        for (int WMPi=0;WMPi<PORT.size();WMPi++)
+            PORT[WMPi]->write(VAL);
 }
 
 template<typename T, typename If>
@@ -75,16 +120,595 @@ public:
     sc_object* oport;
 };
 
+//! A helper class used to drive channels directly from a static scheduler
+/*! A channel in direct mode stores its tokens in a plain ring buffer
+ * which is accessed without any interaction with the SystemC kernel.
+ * This is only safe when the reader and the writer of the channel are
+ * fired sequentially from the same thread in an admissible order.
+ */
+class direct_channel
+{
+public:
+    //! Switches the channel to the direct mode
+    virtual void make_direct() = 0;
+    
+    //! Number of tokens stored in the channel in direct mode
+    virtual unsigned direct_tokens() const = 0;
+};
+
+//! A helper class used to transfer several tokens at once over a channel
+template <typename TokenType>
+class bulk_channel
+{
+public:
+    //! Reads n tokens into a contiguous buffer, blocks until all are read
+    virtual void read_n(TokenType* vals, size_t n) = 0;
+    
+    //! Writes n tokens from a contiguous buffer, blocks until all are written
+    virtual void write_n(const TokenType* vals, size_t n) = 0;
+};
+
+//! A helper class used to move tokens into a channel
+/*! A channel which stores its tokens in a ring buffer takes over the
+ * storage of the moved tokens, while an sc_fifo channel copies them.
+ * Signals only move their tokens in and out in the ring-buffer, broadcast
+ * and direct modes; in the default sc_fifo mode, which has no move
+ * interface, both the writes and the reads copy the tokens.
+ */
+template <typename TokenType>
+class move_channel
+{
+public:
+    //! Moves a token into the channel, blocks if the channel is full
+    virtual void write_move(TokenType&& val) = 0;
+    
+    //! Moves n tokens from a contiguous buffer into the channel
+    /*! The tokens in the buffer are left in a moved-from state.
+     */
+    virtual void move_n(TokenType* vals, size_t n) = 0;
+};
+
+//! A helper class used to pass tokens over a channel without copying them
+/*! The tokens are passed as reference-counted pointers to immutable
+ * values. A channel which does not store such pointers copies the
+ * value on write and allocates a new one on read.
+ * 
+ * The values are allocated as non-const objects (e.g., using
+ * std::make_shared<TokenType>), since the last reader of a token which
+ * reads it by value takes it over instead of copying it.
+ */
+template <typename TokenType>
+class shared_channel
+{
+public:
+    //! Switches the channel to store the tokens as shared pointers
+    virtual void use_broadcast() = 0;
+    
+    //! Does the channel store the tokens as shared pointers?
+    virtual bool is_shared() const = 0;
+    
+    //! Reads a token as a shared pointer, blocks if the channel is empty
+    virtual std::shared_ptr<const TokenType> read_shared() = 0;
+    
+    //! Writes a token as a shared pointer, blocks if the channel is full
+    virtual void write_shared(const std::shared_ptr<const TokenType>& val) = 0;
+};
+
+//! A read-only view of a token read from a channel
+/*! A token read from a channel in the broadcast mode is held by its
+ * shared pointer, so that the readers which only inspect it do not copy
+ * it. Other tokens are held by value.
+ */
+template <typename TokenType>
+class token_view
+{
+public:
+    //! The viewed token
+    const TokenType& operator*() const {return ptr ? *ptr : val;}
+    
+    const TokenType* operator->() const {return &**this;}
+    
+    //! Holds a token by value
+    token_view& operator=(TokenType&& v)
+    {
+        ptr.reset();
+        val = std::move(v);
+        return *this;
+    }
+    
+    //! Holds a shared token
+    token_view& operator=(std::shared_ptr<const TokenType>&& p)
+    {
+        ptr = std::move(p);
+        return *this;
+    }
+    
+    //! Takes the token out of the view
+    /*! A token held by value, or a shared token which no other reader
+     * holds, is moved out, and a shared token is copied otherwise.
+     */
+    TokenType take()
+    {
+        if (!ptr) return std::move(val);
+        std::shared_ptr<const TokenType> p = std::move(ptr);
+        if (p.use_count() == 1)
+            return std::move(const_cast<TokenType&>(*p));
+        return *p;
+    }
+    
+private:
+    TokenType val;
+    std::shared_ptr<const TokenType> ptr;
+};
+
 //! A ForSyDe signal is used to inter-connect processes
+/*! By default a signal is a normal SystemC FIFO. Alternatively, it can
+ * store its tokens in a lock-free single-producer single-consumer ring
+ * buffer, which avoids the per-token update requests of sc_fifo and
+ * only notifies the kernel when the buffer becomes non-empty or
+ * non-full. Ring-buffer channels are selected per signal by calling
+ * use_ring_buffer() during elaboration, or for all signals by defining
+ * the FORSYDE_RING_CHANNELS macro.
+ * 
+ * A signal can also be switched to a broadcast mode by calling
+ * use_broadcast() during elaboration, in which the ring buffer stores
+ * reference-counted pointers to immutable tokens. An output port which
+ * is bound to several such signals allocates each token once and shares
+ * it among all of them. Since a broadcast signal is a ring buffer, it
+ * has the timing and the power-of-two capacity of a ring-buffer channel
+ * described below, which is why the mode is only selected per signal.
+ * 
+ * The readers which use read_shared() or read_view() (i.e., the fanout
+ * processes, the SY comb to comb4, zip, zipX and sink processes and the
+ * SDF sink) receive the shared token without copying it. The other
+ * process constructors, such as the SDF ones which pass vectors of
+ * tokens to their functions, read their tokens by value, so each of them
+ * gets its own copy, except for the last reader of a token which takes
+ * it over by move.
+ * 
+ * The tokens moved into a signal (see move_channel) are only moved, and
+ * read back by move, in the ring-buffer, broadcast and direct modes.
+ * A signal in the default sc_fifo mode copies them on both ends, so
+ * models with heap-backed tokens should use ring-buffer channels.
+ * 
+ * Note that unlike sc_fifo, a token written to a ring-buffer channel
+ * is visible to the reader in the same delta cycle.
+ */
 template <typename T, typename TokenType>
-class signal: public sc_fifo<TokenType>
+class signal: public sc_fifo<TokenType>, public ForSyDe::direct_channel,
+              public ForSyDe::bulk_channel<TokenType>,
+              public ForSyDe::move_channel<TokenType>,
+              public ForSyDe::shared_channel<TokenType>
 #ifdef FORSYDE_INTROSPECTION
             , public ForSyDe::introspective_channel
 #endif
 {
 public:
-    signal() : sc_fifo<TokenType>() {}
-    signal(sc_module_name name, unsigned size) : sc_fifo<TokenType>(name, size) {}
+    signal() : sc_fifo<TokenType>(), fifo_size(16), mode(FIFO)
+    {
+#ifdef FORSYDE_RING_CHANNELS
+        use_ring_buffer();
+#endif
+#ifdef FORSYDE_TRACE_EVENTS
+        trace_track = trace_recorder::instance().add_track(this->name(), false);
+#endif
+    }
+    signal(sc_module_name name, unsigned size) : sc_fifo<TokenType>(name, size), fifo_size(size), mode(FIFO)
+    {
+#ifdef FORSYDE_RING_CHANNELS
+        use_ring_buffer();
+#endif
+#ifdef FORSYDE_TRACE_EVENTS
+        trace_track = trace_recorder::instance().add_track(this->name(), false);
+#endif
+    }
+    
+    virtual void read(TokenType& val)
+    {
+        FORSYDE_PROFILE_CONSUME(1, num_available() == 0);
+        FORSYDE_TRACE_OCCUPANCY();
+        switch (mode)
+        {
+        case FIFO:
+            sc_fifo<TokenType>::read(val);
+            break;
+        case RING:
+            ring_read(*ring, val);
+            break;
+        case SHARED:
+        {
+            std::shared_ptr<const TokenType> ptr;
+            ring_read(*shared, ptr);
+            take_shared(ptr, val);
+            break;
+        }
+        case DIRECT:
+            if (dbuf.empty())
+                SC_REPORT_ERROR(this->name(), "reading from an empty channel in direct mode");
+            val = dbuf.pop();
+            break;
+        }
+    }
+    
+    virtual TokenType read()
+    {
+        TokenType val;
+        read(val);
+        return val;
+    }
+    
+    virtual void read_n(TokenType* vals, size_t n)
+    {
+        switch (mode)
+        {
+        case RING:
+        {
+            FORSYDE_PROFILE_CONSUME(n, ring->size() < n);
+            FORSYDE_TRACE_OCCUPANCY();
+            while (n > 0)
+            {
+                bool was_full = ring->full();
+                size_t cnt = ring->pop_n(vals, n);
+                if (was_full && cnt > 0) ring_read_ev.notify(SC_ZERO_TIME);
+                vals += cnt;
+                n -= cnt;
+                if (n > 0) sc_core::wait(ring_written_ev);
+            }
+            break;
+        }
+        case DIRECT:
+        {
+            FORSYDE_PROFILE_CONSUME(n, false);
+            FORSYDE_TRACE_OCCUPANCY();
+            if (dbuf.size() < n)
+                SC_REPORT_ERROR(this->name(), "reading from an empty channel in direct mode");
+            for (size_t i=0; i<n; i++)
+                vals[i] = dbuf.pop();
+            break;
+        }
+        default:
+            for (size_t i=0; i<n; i++)
+                read(vals[i]);
+        }
+    }
+    
+    virtual std::shared_ptr<const TokenType> read_shared()
+    {
+        if (mode == SHARED)
+        {
+            FORSYDE_PROFILE_CONSUME(1, shared->empty());
+            FORSYDE_TRACE_OCCUPANCY();
+            std::shared_ptr<const TokenType> ptr;
+            ring_read(*shared, ptr);
+            return ptr;
+        }
+        return std::make_shared<TokenType>(read());
+    }
+    
+    virtual bool nb_read(TokenType& val)
+    {
+        FORSYDE_PROFILE_CONSUME(num_available() > 0 ? 1 : 0, false);
+        FORSYDE_TRACE_OCCUPANCY();
+        switch (mode)
+        {
+        case RING:
+            return ring_nb_read(*ring, val);
+        case SHARED:
+        {
+            std::shared_ptr<const TokenType> ptr;
+            if (!ring_nb_read(*shared, ptr)) return false;
+            take_shared(ptr, val);
+            return true;
+        }
+        case DIRECT:
+            if (dbuf.empty()) return false;
+            val = dbuf.pop();
+            return true;
+        default:
+            return sc_fifo<TokenType>::nb_read(val);
+        }
+    }
+    
+    virtual int num_available() const
+    {
+        switch (mode)
+        {
+        case RING: return (int)ring->size();
+        case SHARED: return (int)shared->size();
+        case DIRECT: return (int)dbuf.size();
+        default: return sc_fifo<TokenType>::num_available();
+        }
+    }
+    
+    virtual const sc_event& data_written_event() const
+    {
+        return mode==RING || mode==SHARED ? ring_written_ev : sc_fifo<TokenType>::data_written_event();
+    }
+    
+    virtual void write(const TokenType& val)
+    {
+        FORSYDE_PROFILE_PRODUCE(1, num_free() == 0);
+        FORSYDE_TRACE_OCCUPANCY();
+        switch (mode)
+        {
+        case FIFO:
+            sc_fifo<TokenType>::write(val);
+            break;
+        case RING:
+            ring_write(*ring, val);
+            break;
+        case SHARED:
+            ring_write(*shared, std::make_shared<TokenType>(val));
+            break;
+        case DIRECT:
+            dbuf.push(val);
+            break;
+        }
+    }
+    
+    virtual void write_n(const TokenType* vals, size_t n)
+    {
+        switch (mode)
+        {
+        case RING:
+        {
+            FORSYDE_PROFILE_PRODUCE(n, (size_t)num_free() < n);
+            FORSYDE_TRACE_OCCUPANCY();
+            ring_write_n(vals, n);
+            break;
+        }
+        case DIRECT:
+        {
+            FORSYDE_PROFILE_PRODUCE(n, false);
+            FORSYDE_TRACE_OCCUPANCY();
+            for (size_t i=0; i<n; i++)
+                dbuf.push(vals[i]);
+            break;
+        }
+        default:
+            for (size_t i=0; i<n; i++)
+                write(vals[i]);
+        }
+    }
+    
+    virtual void write_move(TokenType&& val)
+    {
+        switch (mode)
+        {
+        case RING:
+        {
+            FORSYDE_PROFILE_PRODUCE(1, ring->full());
+            FORSYDE_TRACE_OCCUPANCY();
+            ring_write(*ring, std::move(val));
+            break;
+        }
+        case SHARED:
+        {
+            FORSYDE_PROFILE_PRODUCE(1, shared->full());
+            FORSYDE_TRACE_OCCUPANCY();
+            ring_write(*shared, std::make_shared<TokenType>(std::move(val)));
+            break;
+        }
+        case DIRECT:
+        {
+            FORSYDE_PROFILE_PRODUCE(1, false);
+            FORSYDE_TRACE_OCCUPANCY();
+            dbuf.push(std::move(val));
+            break;
+        }
+        default:
+            write(val);
+        }
+    }
+    
+    virtual void move_n(TokenType* vals, size_t n)
+    {
+        switch (mode)
+        {
+        case RING:
+        {
+            FORSYDE_PROFILE_PRODUCE(n, (size_t)num_free() < n);
+            FORSYDE_TRACE_OCCUPANCY();
+            ring_write_n(std::make_move_iterator(vals), n);
+            break;
+        }
+        default:
+            for (size_t i=0; i<n; i++)
+                write_move(std::move(vals[i]));
+        }
+    }
+    
+    virtual void write_shared(const std::shared_ptr<const TokenType>& val)
+    {
+        if (mode == SHARED)
+        {
+            FORSYDE_PROFILE_PRODUCE(1, shared->full());
+            FORSYDE_TRACE_OCCUPANCY();
+            ring_write(*shared, val);
+        }
+        else
+            write(*val);
+    }
+    
+    virtual bool nb_write(const TokenType& val)
+    {
+        FORSYDE_PROFILE_PRODUCE(num_free() > 0 ? 1 : 0, false);
+        FORSYDE_TRACE_OCCUPANCY();
+        switch (mode)
+        {
+        case RING:
+            return ring_nb_write(*ring, val);
+        case SHARED:
+            return ring_nb_write(*shared, std::shared_ptr<const TokenType>(std::make_shared<TokenType>(val)));
+        case DIRECT:
+            dbuf.push(val);
+            return true;
+        default:
+            return sc_fifo<TokenType>::nb_write(val);
+        }
+    }
+    
+    virtual int num_free() const
+    {
+        switch (mode)
+        {
+        case RING: return (int)(ring->capacity()-ring->size());
+        case SHARED: return (int)(shared->capacity()-shared->size());
+        case DIRECT: return (int)(dbuf.capacity()-dbuf.size());
+        default: return sc_fifo<TokenType>::num_free();
+        }
+    }
+    
+    virtual const sc_event& data_read_event() const
+    {
+        return mode==RING || mode==SHARED ? ring_read_ev : sc_fifo<TokenType>::data_read_event();
+    }
+    
+    //! Switches the channel to a ring buffer
+    /*! Should be called before any token is written to the channel. The
+     * capacity of the ring buffer is the size of the signal rounded up
+     * to a power of two.
+     */
+    void use_ring_buffer()
+    {
+        if (mode == DIRECT || mode == SHARED) return;
+        if (!ring) ring.reset(new spsc_ring<TokenType>(fifo_size));
+        mode = RING;
+    }
+    
+    //! Switches the channel to a ring buffer of shared tokens
+    /*! Should be called before any token is written to the channel. Like
+     * use_ring_buffer(), it makes the written tokens visible in the same
+     * delta cycle and rounds the capacity up to a power of two.
+     */
+    virtual void use_broadcast()
+    {
+        if (mode == DIRECT) return;
+        if (!shared) shared.reset(new spsc_ring<std::shared_ptr<const TokenType>>(fifo_size));
+        mode = SHARED;
+    }
+    
+    //! Does the channel store the tokens as shared pointers?
+    virtual bool is_shared() const
+    {
+        return mode == SHARED;
+    }
+    
+    //! Switches the channel to the direct mode
+    /*! Should be called before any token is written to the channel.
+     */
+    virtual void make_direct()
+    {
+        mode = DIRECT;
+    }
+    
+    //! Number of tokens stored in the channel in direct mode
+    virtual unsigned direct_tokens() const
+    {
+        return dbuf.size();
+    }
+    
+private:
+    //! The size of the signal given at construction
+    unsigned fifo_size;
+    
+    //! Where the tokens of the signal are stored
+    enum {FIFO, RING, SHARED, DIRECT} mode;
+    
+    //! The token storage used by ring-buffer channels
+    std::unique_ptr<spsc_ring<TokenType>> ring;
+    
+    //! Copies a shared token into val, or moves it if no other reader holds it
+    /*! The shared tokens are allocated as non-const objects, so the last
+     * reader can take them over.
+     */
+    static void take_shared(std::shared_ptr<const TokenType>& ptr, TokenType& val)
+    {
+        if (ptr.use_count() == 1)
+            val = std::move(const_cast<TokenType&>(*ptr));
+        else
+            val = *ptr;
+    }
+    
+    //! The token storage used by broadcast channels
+    std::unique_ptr<spsc_ring<std::shared_ptr<const TokenType>>> shared;
+    
+    //! Notified when a ring-buffer channel becomes non-empty
+    sc_event ring_written_ev;
+    
+    //! Notified when a ring-buffer channel becomes non-full
+    sc_event ring_read_ev;
+    
+    //! The token storage used in direct mode (driven by a static scheduler)
+    ring_buffer<TokenType> dbuf;
+    
+#ifdef FORSYDE_TRACE_EVENTS
+    //! The counter track of the signal in the trace
+    uint32_t trace_track;
+#endif
+    
+    //! Blocking read from a ring buffer
+    template <typename E>
+    void ring_read(spsc_ring<E>& r, E& val)
+    {
+        bool was_full = r.full();
+        while (!r.pop(val))
+        {
+            sc_core::wait(ring_written_ev);
+            was_full = r.full();
+        }
+        if (was_full) ring_read_ev.notify(SC_ZERO_TIME);
+    }
+    
+    //! Non-blocking read from a ring buffer
+    template <typename E>
+    bool ring_nb_read(spsc_ring<E>& r, E& val)
+    {
+        bool was_full = r.full();
+        if (!r.pop(val)) return false;
+        if (was_full) ring_read_ev.notify(SC_ZERO_TIME);
+        return true;
+    }
+    
+    //! Blocking write (or move) to a ring buffer
+    template <typename E, typename V>
+    void ring_write(spsc_ring<E>& r, V&& val)
+    {
+        bool was_empty = r.empty();
+        while (!r.push(std::forward<V>(val)))
+        {
+            sc_core::wait(ring_read_ev);
+            was_empty = r.empty();
+        }
+        if (was_empty) ring_written_ev.notify(SC_ZERO_TIME);
+    }
+    
+    //! Blocking write of several tokens to the ring buffer
+    template <typename It>
+    void ring_write_n(It vals, size_t n)
+    {
+        while (n > 0)
+        {
+            bool was_empty = ring->empty();
+            size_t cnt = ring->push_n(vals, n);
+            if (was_empty && cnt > 0) ring_written_ev.notify(SC_ZERO_TIME);
+            vals += cnt;
+            n -= cnt;
+            if (n > 0) sc_core::wait(ring_read_ev);
+        }
+    }
+    
+    //! Non-blocking write to a ring buffer
+    template <typename E>
+    bool ring_nb_write(spsc_ring<E>& r, const E& val)
+    {
+        bool was_empty = r.empty();
+        if (!r.push(val)) return false;
+        if (was_empty) ring_written_ev.notify(SC_ZERO_TIME);
+        return true;
+    }
+    
+public:
 #ifdef FORSYDE_INTROSPECTION
     typedef T type;
     
@@ -110,11 +734,41 @@ public:
 struct PortInfo
 {
     sc_object* port;
-    // TODO: remove if proved not to be needed
-    //~ unsigned toks;
+    //! Number of tokens consumed or produced on the port in each firing
+    unsigned toks;
     std::string portType;
 };
 
+//! A helper class used to access the channels bound to a port regardless of its token type
+class untyped_port
+{
+public:
+    //! Whether the port reads from its channels or writes to them
+    virtual bool is_input() const = 0;
+    
+    //! Number of channels bound to the port
+    virtual int channel_count() = 0;
+    
+    //! The i-th channel bound to the port
+    virtual sc_interface* channel(int i) = 0;
+    
+    //! The event to wait for before toks tokens can be transferred without blocking
+    /*! Returns NULL if the port can already transfer the tokens on all
+     * of its bound channels.
+     */
+    virtual const sc_event* blocking_event(unsigned toks) = 0;
+    
+#ifdef FORSYDE_PARALLEL_SIM
+    //! Links the i-th channel bound to the port to another MPI rank
+    /*! An input port sends the tokens written to the channel to the rank
+     * in messages of up to batch tokens, and an output port writes the
+     * tokens received from the rank to the channel. It is called from a
+     * thread which replaces the process of the port and never returns.
+     */
+    virtual void mpi_link(int i, int rank, int tag, unsigned batch) = 0;
+#endif
+};
+
 //! A helper class used to provide introspective ports
 class introspective_port
 {
@@ -131,14 +785,123 @@ public:
 
 //! The in_port port is used for input ports of ForSyDe processes
 template <typename T, typename TokenType, typename ChanType>
-class in_port: public sc_fifo_in<TokenType>
+class in_port: public sc_fifo_in<TokenType>, public ForSyDe::untyped_port
 #ifdef FORSYDE_INTROSPECTION
             , public ForSyDe::introspective_port
 #endif
 {
 public:
-    in_port() : sc_fifo_in<TokenType>(){}
-    in_port(const char* name) : sc_fifo_in<TokenType>(name){}
+    in_port() : sc_fifo_in<TokenType>(), bulk(NULL), shared(NULL), resolved(false) {}
+    in_port(const char* name) : sc_fifo_in<TokenType>(name), bulk(NULL), shared(NULL), resolved(false) {}
+    
+    virtual bool is_input() const {return true;}
+    
+    //! Number of channels bound to the port
+    virtual int channel_count()
+    {
+        return this->size();
+    }
+    
+    //! The i-th channel bound to the port
+    virtual sc_interface* channel(int i)
+    {
+        return (*this)[i];
+    }
+    
+    virtual const sc_event* blocking_event(unsigned toks)
+    {
+        for (int i=0; i<this->size(); i++)
+            if ((unsigned)(*this)[i]->num_available() < toks)
+                return &(*this)[i]->data_written_event();
+        return NULL;
+    }
+    
+#ifdef FORSYDE_PARALLEL_SIM
+    virtual void mpi_link(int i, int rank, int tag, unsigned batch)
+    {
+        if constexpr (has_serializer<TokenType>::value)
+        {
+            std::vector<TokenType> vals;
+            std::vector<char> buf;
+            while (1)
+            {
+                vals.push_back((*this)[i]->read());
+                if (vals.size() < batch && (*this)[i]->num_available() > 0)
+                    continue;
+                send_message(rank, tag, buf, vals);
+                vals.clear();
+            }
+        }
+        else
+            SC_REPORT_ERROR(this->name(), "the token type has no serializer");
+    }
+#endif
+    
+    //! Reads n tokens from the bound channel into a contiguous buffer
+    /*! The tokens are transferred at once if the channel supports it and
+     * one by one otherwise.
+     */
+    void read_n(TokenType* vals, size_t n)
+    {
+        resolve_channel();
+        if (bulk)
+            bulk->read_n(vals, n);
+        else
+            for (size_t i=0; i<n; i++)
+                vals[i] = this->read();
+    }
+    
+    //! Fills a vector with tokens read from the bound channel
+    void read_n(std::vector<TokenType>& vals)
+    {
+        if constexpr (std::is_same<TokenType,bool>::value)
+            for (auto it=vals.begin();it!=vals.end();it++)
+                *it = this->read();
+        else
+            read_n(vals.data(), vals.size());
+    }
+    
+    //! Reads a token from the bound channel as a shared pointer
+    /*! The token is not copied if the channel is in the broadcast mode.
+     */
+    std::shared_ptr<const TokenType> read_shared()
+    {
+        resolve_channel();
+        if (shared)
+            return shared->read_shared();
+        else
+            return std::make_shared<TokenType>(this->read());
+    }
+    
+    //! Reads a token from the bound channel into a view
+    /*! A token of a channel in the broadcast mode is shared with the
+     * other readers, and the other tokens are read by value.
+     */
+    void read_view(token_view<TokenType>& v)
+    {
+        resolve_channel();
+        if (shared && shared->is_shared())
+            v = shared->read_shared();
+        else
+            v = this->read();
+    }
+    
+private:
+    //! The bound channel, if it supports bulk transfers
+    bulk_channel<TokenType>* bulk;
+    //! The bound channel, if it supports shared tokens
+    shared_channel<TokenType>* shared;
+    bool resolved;
+    
+    void resolve_channel()
+    {
+        if (resolved) return;
+        bulk = dynamic_cast<bulk_channel<TokenType>*>((*this)[0]);
+        shared = dynamic_cast<shared_channel<TokenType>*>((*this)[0]);
+        resolved = true;
+    }
+    
+public:
 #ifdef FORSYDE_INTROSPECTION
     typedef T type;
     
@@ -171,14 +934,190 @@ public:
 
 //! The UT_out port is used for output ports of UT processes
 template <typename T, typename TokenType, typename ChanType>
-class out_port: public sc_fifo_out<TokenType>
+class out_port: public sc_fifo_out<TokenType>, public ForSyDe::untyped_port
 #ifdef FORSYDE_INTROSPECTION
             , public ForSyDe::introspective_port
 #endif
 {
 public:
-    out_port() : sc_fifo_out<TokenType>(){}
-    out_port(const char* name) : sc_fifo_out<TokenType>(name){}
+    out_port() : sc_fifo_out<TokenType>(), num_shared(0) {}
+    out_port(const char* name) : sc_fifo_out<TokenType>(name), num_shared(0) {}
+    
+    virtual bool is_input() const {return false;}
+    
+    //! Number of channels bound to the port
+    virtual int channel_count()
+    {
+        return this->size();
+    }
+    
+    //! The i-th channel bound to the port
+    virtual sc_interface* channel(int i)
+    {
+        return (*this)[i];
+    }
+    
+    virtual const sc_event* blocking_event(unsigned toks)
+    {
+        for (int i=0; i<this->size(); i++)
+            if ((unsigned)(*this)[i]->num_free() < toks)
+                return &(*this)[i]->data_read_event();
+        return NULL;
+    }
+    
+#ifdef FORSYDE_PARALLEL_SIM
+    virtual void mpi_link(int i, int rank, int tag, unsigned batch)
+    {
+        if constexpr (has_serializer<TokenType>::value)
+        {
+            std::vector<TokenType> vals;
+            std::vector<char> buf;
+            while (1)
+            {
+                recv_message(rank, tag, buf, vals);
+                for (auto it=vals.begin();it!=vals.end();it++)
+                    (*this)[i]->write(*it);
+            }
+        }
+        else
+            SC_REPORT_ERROR(this->name(), "the token type has no serializer");
+    }
+#endif
+    
+    //! Writes n tokens from a contiguous buffer to all of the bound channels
+    /*! The tokens are transferred at once to the channels which support
+     * it and one by one to the others.
+     */
+    void write_n(const TokenType* vals, size_t n)
+    {
+        resolve_channels();
+        for (size_t i=0; i<bulk.size(); i++)
+            if (bulk[i])
+                bulk[i]->write_n(vals, n);
+            else
+                for (size_t j=0; j<n; j++)
+                    (*this)[i]->write(vals[j]);
+    }
+    
+    //! Writes all tokens of a vector to all of the bound channels
+    void write_n(const std::vector<TokenType>& vals)
+    {
+        if constexpr (std::is_same<TokenType,bool>::value)
+            write_vec_multiport(*this, vals);
+        else
+            write_n(vals.data(), vals.size());
+    }
+    
+    //! Moves n tokens from a contiguous buffer to the bound channels
+    /*! The tokens are copied to all channels except the last one, into
+     * which they are moved. The tokens in the buffer are left in a
+     * moved-from state.
+     */
+    void move_n(TokenType* vals, size_t n)
+    {
+        resolve_channels();
+        if (moves.empty()) return;
+        for (size_t i=0; i<moves.size()-1; i++)
+            if (bulk[i])
+                bulk[i]->write_n(vals, n);
+            else
+                for (size_t j=0; j<n; j++)
+                    (*this)[i]->write(vals[j]);
+        if (moves.back())
+            moves.back()->move_n(vals, n);
+        else
+            for (size_t j=0; j<n; j++)
+                (*this)[moves.size()-1]->write(vals[j]);
+    }
+    
+    //! Moves all tokens of a vector to the bound channels
+    /*! The size of the vector is preserved, so it can be reused for the
+     * next firing.
+     */
+    void move_n(std::vector<TokenType>& vals)
+    {
+        if constexpr (std::is_same<TokenType,bool>::value)
+            write_vec_multiport(*this, vals);
+        else
+            move_n(vals.data(), vals.size());
+    }
+    
+    //! Moves a token to the bound channels
+    /*! The token is copied to all channels except the last one, into
+     * which it is moved. Channels in the broadcast mode share a single
+     * copy of the token. A last channel in the sc_fifo mode copies the
+     * token as well.
+     */
+    void write_move(TokenType&& val)
+    {
+        resolve_channels();
+        if (moves.empty()) return;
+        if (num_shared != 0)
+        {
+            write_shared(std::make_shared<TokenType>(std::move(val)));
+            return;
+        }
+        for (size_t i=0; i<moves.size()-1; i++)
+            (*this)[i]->write(val);
+        if (moves.back())
+            moves.back()->write_move(std::move(val));
+        else
+            (*this)[moves.size()-1]->write(val);
+    }
+    
+    //! Writes a token to all of the bound channels
+    /*! The channels in the broadcast mode share a single copy of the
+     * token, and the others receive their own copies.
+     */
+    void broadcast(const TokenType& val)
+    {
+        resolve_channels();
+        if (num_shared == 0)
+            for (int i=0; i<this->size(); i++)
+                (*this)[i]->write(val);
+        else
+            write_shared(std::make_shared<TokenType>(val));
+    }
+    
+    //! Writes a token given as a shared pointer to all of the bound channels
+    void write_shared(const std::shared_ptr<const TokenType>& val)
+    {
+        resolve_channels();
+        for (size_t i=0; i<shared.size(); i++)
+            if (shared[i])
+                shared[i]->write_shared(val);
+            else
+                (*this)[i]->write(*val);
+    }
+    
+private:
+    //! The bound channels, or NULL for those which do not support bulk transfers
+    std::vector<bulk_channel<TokenType>*> bulk;
+    //! The bound channels, or NULL for those which do not support moving tokens
+    std::vector<move_channel<TokenType>*> moves;
+    //! The bound channels in the broadcast mode, or NULL for the others
+    std::vector<shared_channel<TokenType>*> shared;
+    size_t num_shared;
+    
+    void resolve_channels()
+    {
+        if ((int)bulk.size() == this->size()) return;
+        bulk.clear();
+        moves.clear();
+        shared.clear();
+        num_shared = 0;
+        for (int i=0; i<this->size(); i++)
+        {
+            bulk.push_back(dynamic_cast<bulk_channel<TokenType>*>((*this)[i]));
+            moves.push_back(dynamic_cast<move_channel<TokenType>*>((*this)[i]));
+            auto chan = dynamic_cast<shared_channel<TokenType>*>((*this)[i]);
+            if (chan && !chan->is_shared()) chan = NULL;
+            if (chan) num_shared++;
+            shared.push_back(chan);
+        }
+    }
+    
+public:
 #ifdef FORSYDE_INTROSPECTION
     typedef T type;
     
@@ -225,26 +1164,216 @@ public:
  * instantiated.
  * The designer uses the process constructors which implement the
  * abstract methods in a specific MoC.
+ *
+ * When the FORSYDE_COROUTINES macro is defined (requires C++20), the
+ * processes which report their ports using firingInfo() run as
+ * stackless coroutines resumed from an SC_METHOD instead of SC_THREADs,
+ * which avoids allocating a thread stack for each of them.
  */
 class process : public sc_module
 {
 private:
     //! 
     SC_HAS_PROCESS(process);
+    
+    friend class SDF::static_scheduler;
+    friend class SY::comb_fusion;
+    friend class partitioner;
+    
+    //! Is the process fired by an external scheduler instead of its own thread?
+    bool externally_scheduled;
+    
+    //! Is the process simulated by another MPI rank?
+    /*! A remote process never runs any of its stages.
+     */
+    bool remote;
 
     //! The main and only execution thread of the module
     void worker()
     {
+        // A static scheduler calls all stages of the process itself
+        if (externally_scheduled) return;
         //  We run the init stage here and not in the constructor to
         // force running it after the elaboration phase.
         init();
+        while (1) fire();
+    }
+    
+    //! Runs the prep, exec and prod stages once
+    void fire()
+    {
+#if defined(FORSYDE_PROFILE) || defined(FORSYDE_TRACE_EVENTS)
+#ifdef FORSYDE_PROFILE
+        // Only a static scheduler fires the processes from its own thread
+        if (externally_scheduled)
+        {
+            process_profile::active = &profile;
+            process_profile::active_host = sc_get_current_process_handle().get_parent_object();
+        }
+#endif
+        timed_stage(&process::prep, PREP);
+        timed_stage(&process::exec, EXEC);
+        timed_stage(&process::prod, PROD);
+#ifdef FORSYDE_PROFILE
+        profile.firings++;
+#endif
+#else
+        prep();     // The preparaion stage
+        exec();     // The execution stage
+        prod();     // The production stage
+#endif
+    }
+    
+#if defined(FORSYDE_PROFILE) || defined(FORSYDE_TRACE_EVENTS)
+    //! The stages of the abstract semantics which are timed
+    enum stage_id {PREP, EXEC, PROD};
+    
+    //! Runs a stage and records its duration in the profile and the trace
+    /*! The profile excludes the time blocked on signals.
+     */
+    void timed_stage(void (process::*stage)(), stage_id id)
+    {
+#ifdef FORSYDE_TRACE_EVENTS
+        trace.start(id);
+#endif
+#ifdef FORSYDE_PROFILE
+        auto blocked = profile.blocked;
+        auto start = process_profile::clock::now();
+        (this->*stage)();
+        profile.stages[id] += process_profile::clock::now() - start - (profile.blocked - blocked);
+#else
+        (this->*stage)();
+#endif
+#ifdef FORSYDE_TRACE_EVENTS
+        if (id == PROD) trace.finish(trace_track);
+#endif
+    }
+#endif
+    
+#ifdef FORSYDE_TRACE_EVENTS
+    //! The firing which is being recorded in the trace
+    trace_firing trace;
+#endif
+    
+#ifdef FORSYDE_PROFILE
+    //! All processes of the model, in the order of construction
+    static std::vector<process*>& profiled_processes()
+    {
+        static std::vector<process*> procs;
+        return procs;
+    }
+    
+    //! Writes the profiles of all processes as CSV and JSON files
+    static void write_profiles()
+    {
+        typedef std::chrono::duration<double> seconds;
+        std::ofstream csv(FORSYDE_PROFILE_FILE ".csv");
+        std::ofstream json(FORSYDE_PROFILE_FILE ".json");
+        csv << "process,kind,firings,prep_s,exec_s,prod_s,blocked_s,consumed,produced\n";
+        json << "{\n";
+        auto& procs = profiled_processes();
+        for (size_t i=0; i<procs.size(); i++)
+        {
+            const process_profile& prof = procs[i]->profile;
+            csv << procs[i]->name() << "," << procs[i]->forsyde_kind() << ","
+                << prof.firings << ","
+                << seconds(prof.stages[PREP]).count() << ","
+                << seconds(prof.stages[EXEC]).count() << ","
+                << seconds(prof.stages[PROD]).count() << ","
+                << seconds(prof.blocked).count() << ","
+                << prof.consumed << "," << prof.produced << "\n";
+            json << "  \"" << procs[i]->name() << "\": {"
+                 << "\"kind\": \"" << procs[i]->forsyde_kind() << "\", "
+                 << "\"firings\": " << prof.firings << ", "
+                 << "\"prep_s\": " << seconds(prof.stages[PREP]).count() << ", "
+                 << "\"exec_s\": " << seconds(prof.stages[EXEC]).count() << ", "
+                 << "\"prod_s\": " << seconds(prof.stages[PROD]).count() << ", "
+                 << "\"blocked_s\": " << seconds(prof.blocked).count() << ", "
+                 << "\"consumed\": " << prof.consumed << ", "
+                 << "\"produced\": " << prof.produced << "}"
+                 << (i+1 < procs.size() ? ",\n" : "\n");
+        }
+        json << "}\n";
+    }
+#endif
+
+#ifdef FORSYDE_COROUTINES
+    //! The coroutine type used to run a process without a thread
+    struct firing_loop
+    {
+        struct promise_type
+        {
+            firing_loop get_return_object()
+            {
+                return {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept {return {};}
+            std::suspend_always final_suspend() noexcept {return {};}
+            void return_void() {}
+            void unhandled_exception() {throw;}
+        };
+        
+        std::coroutine_handle<promise_type> handle;
+    };
+    
+    //! The suspended execution of the process when it runs as a coroutine
+    std::coroutine_handle<firing_loop::promise_type> coro;
+    
+    //! The event which the coroutine waits for
+    const sc_event* trigger;
+    
+    //! The execution loop of the process as a stackless coroutine
+    /*! It is equivalent to worker(), except that before the prep and
+     * prod stages it suspends until they can transfer their tokens
+     * without blocking.
+     */
+    firing_loop coworker()
+    {
+        if (externally_scheduled) co_return;
+        init();
+        // The ports are collected after the elaboration passes
+        std::vector<PortInfo> ins, outs;
+        firingInfo(ins, outs);
+        std::vector<untyped_port*> iports, oports;
+        for (auto it=ins.begin();it!=ins.end();it++)
+            iports.push_back(dynamic_cast<untyped_port*>(it->port));
+        for (auto it=outs.begin();it!=outs.end();it++)
+            oports.push_back(dynamic_cast<untyped_port*>(it->port));
         while (1)
         {
-            prep();     // The preparaion stage
-            exec();     // The execution stage
-            prod();     // The production stage
+            if (reads_inputs())
+                for (auto it=iports.begin();it!=iports.end();it++)
+                    while ((trigger = (*it)->blocking_event(1)) != NULL)
+                        co_await std::suspend_always();
+#if defined(FORSYDE_PROFILE) || defined(FORSYDE_TRACE_EVENTS)
+            timed_stage(&process::prep, PREP);
+            timed_stage(&process::exec, EXEC);
+#else
+            prep();
+            exec();
+#endif
+            for (auto it=oports.begin();it!=oports.end();it++)
+                while ((trigger = (*it)->blocking_event(1)) != NULL)
+                    co_await std::suspend_always();
+#if defined(FORSYDE_PROFILE) || defined(FORSYDE_TRACE_EVENTS)
+            timed_stage(&process::prod, PROD);
+#else
+            prod();
+#endif
+#ifdef FORSYDE_PROFILE
+            profile.firings++;
+#endif
         }
     }
+    
+    //! The method which resumes the coroutine each time its event is notified
+    void resume()
+    {
+        if (!coro) coro = coworker().handle;
+        coro.resume();
+        if (!coro.done()) next_trigger(*trigger);
+    }
+#endif
 
 protected:
     //! The init stage
@@ -281,9 +1410,62 @@ protected:
     //! This hook is used to run the clean stage
     void end_of_simulation()
     {
-        clean();
+        if (!remote) clean();
+#ifdef FORSYDE_PROFILE
+        // The last process to finish writes the profiles of all of them
+        static size_t finished = 0;
+        if (++finished == profiled_processes().size())
+            write_profiles();
+#endif
+#ifdef FORSYDE_TRACE_EVENTS
+        trace_recorder::instance().process_finished();
+#endif
+    }
+    
+#ifdef FORSYDE_COROUTINES
+    //! This hook is used to choose between a thread and a coroutine for the process
+    void before_end_of_elaboration()
+    {
+        std::vector<PortInfo> ins, outs;
+        bool unit_rates = firingInfo(ins, outs) && !ins.empty();
+        for (auto it=ins.begin();it!=ins.end();it++)
+            if (it->toks != 1) unit_rates = false;
+        for (auto it=outs.begin();it!=outs.end();it++)
+            if (it->toks != 1) unit_rates = false;
+        if (unit_rates)
+            SC_METHOD(resume);
+        else
+            SC_THREAD(worker);
     }
     
+    //! This method is called to check if the process can run as a coroutine
+    /*! Processes which transfer a fixed number of tokens on each of their
+     * ports in every firing and never suspend otherwise can save the
+     * pointers to their ports together with the token rates in ins and
+     * outs and return true.
+     * Such processes with at least one input and one token on each port
+     * run as coroutines, while the others (e.g., sources which suspend
+     * after producing their last token) keep their own threads.
+     * The init stage of a coroutine runs in an SC_METHOD too, so
+     * processes whose init stage may block (e.g., writing several
+     * initial tokens) should return false.
+     */
+    virtual bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        return false;
+    }
+    
+    //! This method is called before each firing of a coroutine to check if it reads its inputs
+    /*! Processes which skip reading in some firings (e.g., the first
+     * firing of a Moore machine) return false for them, so that the
+     * coroutine does not wait for their input tokens.
+     */
+    virtual bool reads_inputs() const
+    {
+        return true;
+    }
+#endif
+    
 #ifdef FORSYDE_INTROSPECTION
 
     //! This hook is used to collect additional structural information
@@ -302,6 +1484,16 @@ protected:
 
 public:
 
+#ifdef FORSYDE_PROFILE
+    //! The execution statistics of the process
+    process_profile profile;
+#endif
+
+#ifdef FORSYDE_TRACE_EVENTS
+    //! The track of the process in the trace
+    uint32_t trace_track;
+#endif
+
 #ifdef FORSYDE_INTROSPECTION
     //! Pointers to the input ports and their bound channels
     std::vector<PortInfo> boundInChans;
@@ -317,16 +1509,46 @@ public:
      * processes them and writes the results using the output port.
      */
     process(sc_module_name _name    ///< The name of the ForSyDe process
-            ): sc_module(_name)
+            ): sc_module(_name), externally_scheduled(false), remote(false)
     {
+#ifndef FORSYDE_COROUTINES
         SC_THREAD(worker);
+#endif
+#ifdef FORSYDE_PROFILE
+        profiled_processes().push_back(this);
+#endif
+#ifdef FORSYDE_TRACE_EVENTS
+        trace_track = trace_recorder::instance().add_track(name(), true);
+#endif
+    }
+    
+#ifdef FORSYDE_COROUTINES
+    virtual ~process()
+    {
+        if (coro) coro.destroy();
     }
+#endif
     
     //! The ForSyDe process type represented by the current module
     virtual std::string forsyde_kind() const = 0;
     
 };
 
+#ifdef FORSYDE_PROFILE
+inline process_profile* current_profile()
+{
+    sc_process_handle h = sc_get_current_process_handle();
+    if (!h.valid()) return NULL;
+    sc_object* parent = h.get_parent_object();
+    if (process* p = dynamic_cast<process*>(parent))
+        return &p->profile;
+    // The processes fired from the thread of a static scheduler
+    if (parent != NULL && parent == process_profile::active_host)
+        return process_profile::active;
+    return NULL;
+}
+#endif
+
 }
 
 #endif
@@ -0,0 +1,196 @@
+/**********************************************************************
+    * batch_sim.hpp -- Batches of simulations of an elaborated model  *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Running parameter sweeps of the same model in forked   *
+    *          processes which share its elaboration                  *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef BATCH_SIM_HPP
+#define BATCH_SIM_HPP
+
+/*! \file batch_sim.hpp
+ * \brief Implements parameter sweeps over forked simulations
+ *
+ *  This file includes a runner for the many simulations of the same
+ * model which make up a parameter sweep or a Monte-Carlo study. The
+ * model is constructed once in sc_main, and each run is simulated in a
+ * process forked from it, which shares the constructed model copy-on-write.
+ * The runs are set up through a hook which receives the index of the run,
+ * and their results are serialized back to the parent through pipes.
+ *
+ * For example, a model whose source reads its amplitude in its init
+ * stage can be swept as:
+ * \code
+ * top top1("top1");
+ * std::vector<double> peaks;
+ * run_sweep<double>(100,
+ *     [&](size_t run) {amplitude = 0.1*run;},
+ *     [&](size_t run) {return top1.peak;},
+ *     peaks, sc_time(1,SC_MS));
+ * \endcode
+ */
+
+#include <cerrno>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+#include "serialization.hpp"
+
+namespace ForSyDe
+{
+
+using namespace sc_core;
+
+//! The index of the current run started by run_sweep(), or -1
+inline long& sweep_run()
+{
+    static long run = -1;
+    return run;
+}
+
+//! Simulates a number of runs of the constructed model in forked processes
+/*! Up to workers runs (by default, one per online processor) are
+ * simulated at the same time. Each run calls setup with its index,
+ * simulates the model for the given duration (or until there is no
+ * more activity) and calls collect to obtain its result. The result is
+ * transmitted to the parent using the serializer trait and stored in
+ * results at the index of the run.
+ *
+ * Since the simulation of each run starts in its own process, the
+ * function should be called from sc_main after the model is constructed
+ * and before sc_start. The hooks may change any state of the model, and
+ * the processes read the changed state in their init stages. Returns
+ * the number of runs which failed, whose results are default constructed.
+ */
+template <typename R>
+inline int run_sweep(size_t runs,
+                     const std::function<void(size_t)>& setup,
+                     const std::function<R(size_t)>& collect,
+                     std::vector<R>& results,
+                     const sc_time& duration=sc_max_time(),
+                     unsigned workers=0)
+{
+    if (sc_get_status() != SC_ELABORATION)
+        SC_REPORT_ERROR("run_sweep", "the sweep should start before the simulation");
+    if (workers == 0)
+        workers = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+
+    // A forked run whose result is being read
+    struct worker
+    {
+        pid_t pid;
+        int fd;
+        size_t run;
+        std::vector<char> buf;
+    };
+
+    results.assign(runs, R());
+    std::vector<worker> active;
+    size_t next = 0;
+    int failed = 0;
+    while (next < runs || !active.empty())
+    {
+        while (next < runs && active.size() < workers)
+        {
+            int fds[2];
+            if (pipe(fds) != 0)
+            {
+                SC_REPORT_WARNING("run_sweep", "cannot create a pipe");
+                failed++;
+                next++;
+                continue;
+            }
+            std::cout.flush();
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                close(fds[0]);
+                sweep_run() = next;
+                int status = 0;
+                try
+                {
+                    if (setup) setup(next);
+                    if (duration == sc_max_time())
+                        sc_start();
+                    else
+                        sc_start(duration);
+                    std::vector<char> buf;
+                    pack(collect(next), buf);
+                    for (size_t done=0; done<buf.size();)
+                    {
+                        ssize_t n = write(fds[1], buf.data()+done, buf.size()-done);
+                        if (n < 0 && errno == EINTR) continue;
+                        if (n <= 0) {status = 1; break;}
+                        done += n;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "run " << next << ": " << e.what() << std::endl;
+                    status = 1;
+                }
+                std::cout.flush();
+                _exit(status);
+            }
+            close(fds[1]);
+            if (pid < 0)
+            {
+                close(fds[0]);
+                SC_REPORT_WARNING("run_sweep", "cannot fork a run");
+                failed++;
+            }
+            else
+                active.push_back({pid, fds[0], next, {}});
+            next++;
+        }
+        if (active.empty()) continue;
+
+        // Reads the results from all runs which have written them
+        std::vector<pollfd> pfds;
+        for (auto it=active.begin();it!=active.end();it++)
+            pfds.push_back({it->fd, POLLIN, 0});
+        if (poll(pfds.data(), pfds.size(), -1) < 0) continue;
+        for (size_t i=pfds.size(); i-- > 0;)
+        {
+            if (pfds[i].revents == 0) continue;
+            worker& w = active[i];
+            char chunk[4096];
+            ssize_t n = read(w.fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) continue;
+            if (n > 0)
+            {
+                w.buf.insert(w.buf.end(), chunk, chunk+n);
+                continue;
+            }
+            // The run has finished
+            close(w.fd);
+            int status = -1;
+            waitpid(w.pid, &status, 0);
+            if (n == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            {
+                const char* p = w.buf.data();
+                unpack(p, results[w.run]);
+            }
+            else
+                failed++;
+            active.erase(active.begin()+i);
+        }
+    }
+    return failed;
+}
+
+}
+
+#endif
@@ -40,14 +40,15 @@ using namespace sc_core;
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If>
-inline comb* make_comb(std::string pName,
-    typename comb::functype _func,
+template <class OIf, class I1If,
+          class T0=typename OIf::value_type, class T1=typename I1If::value_type>
+inline basic_comb<T0,T1>* make_comb(std::string pName,
+    typename basic_comb<T0,T1>::functype _func,
     OIf& outS,
     I1If& inp1S
     )
 {
-    auto p = new comb(pName.c_str(), _func);
+    auto p = new basic_comb<T0,T1>(pName.c_str(), _func);
     
     (*p).iport1(inp1S);
     (*p).oport1(outS);
@@ -62,15 +63,17 @@ inline comb* make_comb(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If, class I2If>
-inline comb2* make_comb2(std::string pName,
-    typename comb2::functype _func,
+template <class OIf, class I1If, class I2If,
+          class T0=typename OIf::value_type, class T1=typename I1If::value_type,
+          class T2=typename I2If::value_type>
+inline basic_comb2<T0,T1,T2>* make_comb2(std::string pName,
+    typename basic_comb2<T0,T1,T2>::functype _func,
     OIf& outS,
     I1If& inp1S,
     I2If& inp2S
     )
 {
-    auto p = new comb2(pName.c_str(), _func);
+    auto p = new basic_comb2<T0,T1,T2>(pName.c_str(), _func);
     
     (*p).iport1(inp1S);
     (*p).iport2(inp2S);
@@ -86,14 +89,15 @@ inline comb2* make_comb2(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf, std::size_t N>
-inline combX<N>* make_combX(std::string pName,
-    typename combX<N>::functype _func,
+template <class OIf, class IIf, std::size_t N,
+          class T0=typename OIf::value_type, class T1=typename IIf::value_type>
+inline basic_combX<T0,T1,N>* make_combX(std::string pName,
+    typename basic_combX<T0,T1,N>::functype _func,
     OIf& outS,
     std::array<IIf,N>& inpS
     )
 {
-    auto p = new combX<N>(pName.c_str(), _func);
+    auto p = new basic_combX<T0,T1,N>(pName.c_str(), _func);
     
     for (int i=0;i<N;i++)
     	(*p).iport[i](inpS[i]);
@@ -109,14 +113,14 @@ inline combX<N>* make_combX(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class IIf, class OIf>
-inline delay* make_delay(std::string pName,
+template <class IIf, class OIf, class T=typename OIf::value_type>
+inline basic_delay<T>* make_delay(std::string pName,
     sc_time delay_time,
     OIf& outS,
     IIf& inpS
     )
 {
-    auto p = new delay(pName.c_str(), delay_time);
+    auto p = new basic_delay<T>(pName.c_str(), delay_time);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -131,14 +135,14 @@ inline delay* make_delay(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class IIf, class OIf>
-inline shift* make_shift(std::string pName,
+template <class IIf, class OIf, class T=typename OIf::value_type>
+inline basic_shift<T>* make_shift(std::string pName,
     sc_time delay_time,
     OIf& outS,
     IIf& inpS
     )
 {
-    auto p = new shift(pName.c_str(), delay_time);
+    auto p = new basic_shift<T>(pName.c_str(), delay_time);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -153,14 +157,14 @@ inline shift* make_shift(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the output FIFOs.
  */
-template <class OIf>
-inline constant* make_constant(std::string pName,
-    CTTYPE init_val,
+template <class OIf, class T=typename OIf::value_type>
+inline basic_constant<T>* make_constant(std::string pName,
+    T init_val,
     sc_time end_time,
     OIf& outS
     )
 {
-    auto p = new constant(pName.c_str(), init_val, end_time);
+    auto p = new basic_constant<T>(pName.c_str(), init_val, end_time);
     
     (*p).oport1(outS);
     
@@ -174,14 +178,14 @@ inline constant* make_constant(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the output FIFOs.
  */
-template <class OIf>
-inline source* make_source(std::string pName,
-    typename source::functype _func,
+template <class OIf, class T=typename OIf::value_type>
+inline basic_source<T>* make_source(std::string pName,
+    typename basic_source<T>::functype _func,
     const sc_time& end_time,
     OIf& outS
     )
 {
-    auto p = new source(pName.c_str(), _func, end_time);
+    auto p = new basic_source<T>(pName.c_str(), _func, end_time);
     
     (*p).oport1(outS);
     
@@ -195,14 +199,14 @@ inline source* make_source(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input FIFOs.
  */
-template <class IIf>
-inline sink* make_sink(std::string pName,
-    typename sink::functype _func,
+template <class IIf, class T=typename IIf::value_type>
+inline basic_sink<T>* make_sink(std::string pName,
+    typename basic_sink<T>::functype _func,
     sc_time sampling_period,
     IIf& inS
     )
 {
-    auto p = new sink(pName.c_str(), _func, sampling_period);
+    auto p = new basic_sink<T>(pName.c_str(), _func, sampling_period);
     
     (*p).iport1(inS);
     
@@ -216,13 +220,13 @@ inline sink* make_sink(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input FIFOs.
  */
-template <class IIf>
-inline traceSig* make_traceSig(std::string pName,
+template <class IIf, class T=typename IIf::value_type>
+inline basic_traceSig<T>* make_traceSig(std::string pName,
     sc_time sampling_period,
     IIf& inpS
     )
 {
-    auto p = new traceSig(pName.c_str(), sampling_period);
+    auto p = new basic_traceSig<T>(pName.c_str(), sampling_period);
     
     (*p).iport1(inpS);
     
@@ -236,13 +240,13 @@ inline traceSig* make_traceSig(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class IIf, class OIf>
-inline fanout* make_fanout(std::string pName,
+template <class IIf, class OIf, class T=typename OIf::value_type>
+inline basic_fanout<T>* make_fanout(std::string pName,
     OIf& outS,
     IIf& inpS
     )
 {
-    auto p = new fanout(pName.c_str());
+    auto p = new basic_fanout<T>(pName.c_str());
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
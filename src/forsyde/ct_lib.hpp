@@ -16,6 +16,7 @@
 #include "ct_moc.hpp"
 #include "dde_moc.hpp"
 #include "mis.hpp"
+#include "state_space.hpp"
 
 /*! \file ct_lib.hpp
  * \brief Implements extra facilities on top of the CT MoC
@@ -30,26 +31,43 @@ namespace ForSyDe
 namespace CT
 {
 
+//! Sets the shape of out to inp1 + k*inp2 if it has a closed form
+template <typename T>
+inline bool add_shapes(basic_sub_signal<T>& out, const basic_sub_signal<T>& inp1,
+                       const basic_sub_signal<T>& inp2, const T& k)
+{
+    const basic_poly_shape<T>* s1 = get_shape(inp1);
+    const basic_poly_shape<T>* s2 = get_shape(inp2);
+    if (s1 == NULL || s2 == NULL) return false;
+    basic_poly_shape<T> res = *s1;
+    if (!res.add(*s2, k)) return false;
+    set_shape(out, res);
+    return true;
+}
+
 //! Helper function to construct a coasine source
 /*! This class is used to cretae a continuous-time signal source which
  * produces a sinosoid.
  */
-class sine : public source
+template <typename T>
+class basic_sine : public basic_source<T>
 {
 public:
-    sine(sc_module_name name_,      ///< The Process name
-           const sc_time& endT,     ///< The end time of the generated signal
-           const sc_time& period,   ///< The signal period (1/f)
-           const CTTYPE& ampl      ///< The signal amplitude
-           ) : source(name_, [=](CTTYPE& out, const sc_time& t)
-                              {
-                                  out = ampl*sin(2*M_PI*t/period);
-                              }, endT) {}
+    basic_sine(sc_module_name name_,      ///< The Process name
+               const sc_time& endT,       ///< The end time of the generated signal
+               const sc_time& period,     ///< The signal period (1/f)
+               const T& ampl              ///< The signal amplitude
+               ) : basic_source<T>(name_,
+                       basic_poly_shape<T>::sinusoid(ampl, 2*M_PI/period.to_seconds()),
+                       endT) {}
 
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::sine";}
 };
 
+//! The sine source of CTTYPE signals
+typedef basic_sine<CTTYPE> sine;
+
 //! Helper function to construct a sine source process
 /*! This function is used to construct a sine source and connect its
  * output signals.
@@ -57,15 +75,15 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf>
-inline sine* make_sine(std::string pName,
+template <class OIf, class T=typename OIf::value_type>
+inline basic_sine<T>* make_sine(std::string pName,
     const sc_time& endT,  ///< The end time of the generated signal
     const sc_time& period,///< The signal period (1/f)
-    const CTTYPE& ampl,  ///< The signal amplitude
+    const T& ampl,  ///< The signal amplitude
     OIf& outS
     )
 {
-    auto p = new sine(pName.c_str(), endT, period, ampl);
+    auto p = new basic_sine<T>(pName.c_str(), endT, period, ampl);
 
     (*p).oport1(outS);
 
@@ -76,22 +94,25 @@ inline sine* make_sine(std::string pName,
 /*! This class is used to cretae a continuous-time signal source which
  * produces a cosine wave.
  */
-class cosine : public source
+template <typename T>
+class basic_cosine : public basic_source<T>
 {
 public:
-    cosine(sc_module_name name_,      ///< The Process name
-           const sc_time& endT,       ///< The end time of the generated signal
-           const sc_time& period,     ///< The signal period (1/f)
-           const CTTYPE& ampl         ///< The signal amplitude
-           ) : source(name_, [=](CTTYPE& out, const sc_time& t)
-                              {
-                                  out = ampl*cos(2*M_PI*t/period);
-                              }, endT) {}
+    basic_cosine(sc_module_name name_,      ///< The Process name
+                 const sc_time& endT,       ///< The end time of the generated signal
+                 const sc_time& period,     ///< The signal period (1/f)
+                 const T& ampl              ///< The signal amplitude
+                 ) : basic_source<T>(name_,
+                         basic_poly_shape<T>::sinusoid(ampl, 2*M_PI/period.to_seconds(), M_PI/2),
+                         endT) {}
 
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::cosine";}
 };
 
+//! The cosine source of CTTYPE signals
+typedef basic_cosine<CTTYPE> cosine;
+
 //! Helper function to construct a cosine source process
 /*! This function is used to construct a cosine source and connect its
  * output signals.
@@ -99,15 +120,15 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf>
-inline cosine* make_cosine(std::string pName,
+template <class OIf, class T=typename OIf::value_type>
+inline basic_cosine<T>* make_cosine(std::string pName,
     const sc_time& endT,  ///< The end time of the generated signal
     const sc_time& period,///< The signal period (1/f)
-    const CTTYPE& ampl,  ///< The signal amplitude
+    const T& ampl,  ///< The signal amplitude
     OIf& outS
     )
 {
-    auto p = new cosine(pName.c_str(), endT, period, ampl);
+    auto p = new basic_cosine<T>(pName.c_str(), endT, period, ampl);
 
     (*p).oport1(outS);
 
@@ -164,22 +185,36 @@ inline square* make_square(std::string pName,
 //! Process constructor for a continuous-time process which scales the input
 /*! This class is used to build continuous-time processes with one input
  * and one output. By passing a constant value to the constructor, the
- * process scales the inputs using it.
+ * process scales the inputs using it. For vector values, the scaling
+ * factor is applied element-wise.
  */
-class scale : public comb
+template <typename T>
+class basic_scale : public basic_comb<T,T>
 {
 public:
-    scale(sc_module_name name_,             ///< The Process name
-           const CTTYPE& scaling_factor    ///< The scaling factor
-           ) : comb(name_, [=](CTTYPE& out1, const CTTYPE& inp1)
+    basic_scale(sc_module_name name_,             ///< The Process name
+                const T& scaling_factor          ///< The scaling factor
+                ) : basic_comb<T,T>(name_, [=](T& out1, const T& inp1)
                              {
                                 out1 = scaling_factor * inp1;
+                             },
+                    [=](basic_sub_signal<T>& out1, const basic_sub_signal<T>& inp1)
+                             {
+                                const basic_poly_shape<T>* s = get_shape(inp1);
+                                if (s == NULL) return false;
+                                basic_poly_shape<T> res = *s;
+                                res.scale(scaling_factor);
+                                set_shape(out1, res);
+                                return true;
                              }) {}
 
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::scale";}
 };
 
+//! The scale process of CTTYPE signals
+typedef basic_scale<CTTYPE> scale;
+
 //! Helper function to construct a scale process
 /*! This function is used to construct a scale source and connect its
  * input and output signals.
@@ -187,14 +222,14 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf>
-inline scale* make_scale(std::string pName,
-    const CTTYPE& scaling_factor,       ///< The scaling factor
+template <class OIf, class IIf, class T=typename OIf::value_type>
+inline basic_scale<T>* make_scale(std::string pName,
+    const T& scaling_factor,       ///< The scaling factor
     OIf& outS,
     IIf& inpS
     )
 {
-    auto p = new scale(pName.c_str(), scaling_factor);
+    auto p = new basic_scale<T>(pName.c_str(), scaling_factor);
 
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -206,19 +241,28 @@ inline scale* make_scale(std::string pName,
 /*! This class is used to build continuous-time processes with two inputs
  * and one output. The process adds its two inputs and produces the output.
  */
-class add : public comb2
+template <typename T>
+class basic_add : public basic_comb2<T,T,T>
 {
 public:
-    add(sc_module_name name_        ///< The Process name
-        ) : comb2(name_, [=](CTTYPE& out1, const CTTYPE& inp1, const CTTYPE& inp2)
+    basic_add(sc_module_name name_        ///< The Process name
+        ) : basic_comb2<T,T,T>(name_, [=](T& out1, const T& inp1, const T& inp2)
                              {
                                 out1 = inp1 + inp2;
+                             },
+                    [=](basic_sub_signal<T>& out1, const basic_sub_signal<T>& inp1,
+                        const basic_sub_signal<T>& inp2)
+                             {
+                                return add_shapes(out1, inp1, inp2, T(1));
                              }) {}
 
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::add";}
 };
 
+//! The add process of CTTYPE signals
+typedef basic_add<CTTYPE> add;
+
 //! Helper function to construct an add process
 /*! This function is used to construct an adder and connect its
  * input and output signals.
@@ -226,14 +270,14 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf1, class IIf2>
-inline add* make_add(std::string pName,
+template <class OIf, class IIf1, class IIf2, class T=typename OIf::value_type>
+inline basic_add<T>* make_add(std::string pName,
     OIf& outS,
     IIf1& inp1S,
     IIf2& inp2S
     )
 {
-    auto p = new add(pName.c_str());
+    auto p = new basic_add<T>(pName.c_str());
 
     (*p).iport1(inp1S);
     (*p).iport2(inp2S);
@@ -247,19 +291,28 @@ inline add* make_add(std::string pName,
  * and one output. The process subtracts the second input from the first
  * and produces the output.
  */
-class sub : public comb2
+template <typename T>
+class basic_sub : public basic_comb2<T,T,T>
 {
 public:
-    sub(sc_module_name name_        ///< The Process name
-        ) : comb2(name_, [=](CTTYPE& out1, const CTTYPE& inp1, const CTTYPE& inp2)
+    basic_sub(sc_module_name name_        ///< The Process name
+        ) : basic_comb2<T,T,T>(name_, [=](T& out1, const T& inp1, const T& inp2)
                              {
                                 out1 = inp1 - inp2;
+                             },
+                    [=](basic_sub_signal<T>& out1, const basic_sub_signal<T>& inp1,
+                        const basic_sub_signal<T>& inp2)
+                             {
+                                return add_shapes(out1, inp1, inp2, T(-1));
                              }) {}
 
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::sub";}
 };
 
+//! The sub process of CTTYPE signals
+typedef basic_sub<CTTYPE> sub;
+
 //! Helper function to construct a sub process
 /*! This function is used to construct a subtractor and connect its
  * input and output signals.
@@ -267,14 +320,14 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf1, class IIf2>
-inline sub* make_sub(std::string pName,
+template <class OIf, class IIf1, class IIf2, class T=typename OIf::value_type>
+inline basic_sub<T>* make_sub(std::string pName,
     OIf& outS,
     IIf1& inp1S,
     IIf2& inp2S
     )
 {
-    auto p = new sub(pName.c_str());
+    auto p = new basic_sub<T>(pName.c_str());
 
     (*p).iport1(inp1S);
     (*p).iport2(inp2S);
@@ -287,11 +340,12 @@ inline sub* make_sub(std::string pName,
 /*! This class is used to build continuous-time processes with two inputs
  * and one output. The process multiplies its two inputs and produces the output.
  */
-class mul : public comb2
+template <typename T>
+class basic_mul : public basic_comb2<T,T,T>
 {
 public:
-    mul(sc_module_name name_        ///< The Process name
-        ) : comb2(name_, [=](CTTYPE& out1, const CTTYPE& inp1, const CTTYPE& inp2)
+    basic_mul(sc_module_name name_        ///< The Process name
+        ) : basic_comb2<T,T,T>(name_, [=](T& out1, const T& inp1, const T& inp2)
                              {
                                 out1 = inp1 * inp2;
                              }) {}
@@ -300,6 +354,9 @@ public:
     std::string forsyde_kind() const {return "CT::mul";}
 };
 
+//! The mul process of CTTYPE signals
+typedef basic_mul<CTTYPE> mul;
+
 //! Helper function to construct a mul process
 /*! This function is used to construct a multiplier and connect its
  * input and output signals.
@@ -307,14 +364,14 @@ public:
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf1, class IIf2>
-inline mul* make_mul(std::string pName,
+template <class OIf, class IIf1, class IIf2, class T=typename OIf::value_type>
+inline basic_mul<T>* make_mul(std::string pName,
     OIf& outS,
     IIf1& inp1S,
     IIf2& inp2S
     )
 {
-    auto p = new mul(pName.c_str());
+    auto p = new basic_mul<T>(pName.c_str());
 
     (*p).iport1(inp1S);
     (*p).iport2(inp2S);
@@ -377,48 +434,195 @@ inline gaussian* make_gaussian(std::string pName,
 
 //! Process constructor for implementing a linear filter
 /*! This class is used to build a process which implements a linear
- * in the CT MoC filter based on the numerator and denominator constants.
- * It internally uses a DDE filter together with CT2DDE and DDE2CT MoC
- * interfaces.
+ * filter in the CT MoC based on the numerator and denominator constants.
+ *
+ * The process integrates the state-space model of the filter directly
+ * on the input sub-signals with the chosen solver. The steps are at
+ * most max_step long and end at the ends of the input sub-signals. In
+ * the adaptive mode, a step is accepted if its estimated error is below
+ * tol_error (or it is not longer than min_step), and the next step is
+ * sized by a PI controller. Each accepted step is written as an output
+ * sub-signal whose shape is the cubic Hermite interpolation of the states.
+ *
+ * The coefficients are scalars; for a ct_vector value type each element
+ * of the signal is filtered independently.
  */
-SC_MODULE(filter)
+template <typename T>
+class basic_filter : public ct_process
 {
-    CT_in iport1;           ///< port for the input channel
-    CT_out oport1;          ///< port for the output channel;
-
-    CT2DDE<CTTYPE> ct2de1;
-    DDE::filter<CTTYPE> filter1;
-    DDE2CT<CTTYPE> de2ct1;
-
-    DDE::DDE2DDE<CTTYPE> inp_sig, out_sig;
-    DDE::DDE2DDE<unsigned int> smp_sig;
+public:
+    basic_CT_in<T>  iport1;     ///< port for the input channel
+    basic_CT_out<T> oport1;     ///< port for the output channel
 
     //! The constructor requires the module name and the filter parameters
-    /*!
+    /*! It creates an SC_THREAD which reads the input sub-signals,
+     * integrates the filter over them and writes the output sub-signals.
      */
-    filter(sc_module_name _name,            ///< Process name
-           std::vector<CTTYPE> numerators,  ///< Numerator constants
-           std::vector<CTTYPE> denominators,///< Denominator constants
-           sc_time sample_period,           ///< sampling period
-           sc_time min_step=sc_time(0.05,SC_NS),///< Minimum time step
-           double tol_error=1e-5            ///< Tolerated error
-          ) : sc_module(_name), ct2de1("ct2de1"),
-              filter1("filter1", numerators, denominators, sample_period, min_step, tol_error),
-              de2ct1("de2ct1", HOLD)
+    basic_filter(sc_module_name _name,            ///< Process name
+                 std::vector<CTTYPE> numerators,  ///< Numerator constants
+                 std::vector<CTTYPE> denominators,///< Denominator constants
+                 sc_time max_step,                ///< Maximum time step
+                 sc_time min_step=sc_time(0.05,SC_NS),///< Minimum time step
+                 double tol_error=1e-5,           ///< Tolerated error
+                 filter_solver solver=RK4         ///< Solver of the filter
+                ) : basic_filter(_name, numerators, denominators, max_step,
+                                 min_step, tol_error, solver, true) {}
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return adaptive ? "CT::filter" : "CT::filterf";}
+
+protected:
+    //! The constructor used for both the adaptive and fixed step filters
+    basic_filter(sc_module_name _name, const std::vector<CTTYPE>& numerators,
+                 const std::vector<CTTYPE>& denominators, sc_time max_step,
+                 sc_time min_step, double tol_error, filter_solver solver,
+                 bool adaptive
+                ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
+                    numerators(numerators), denominators(denominators),
+                    max_step(max_step), min_step(min_step),
+                    tol_error(tol_error), solver(solver), adaptive(adaptive)
     {
-        ct2de1.iport1(iport1);
-        ct2de1.iport2(smp_sig);
-        ct2de1.oport1(inp_sig);
+#ifdef FORSYDE_INTROSPECTION
+        std::stringstream ss;
+        ss << numerators;
+        arg_vec.push_back(std::make_tuple("numerators", ss.str()));
+        ss.str("");
+        ss << denominators;
+        arg_vec.push_back(std::make_tuple("denominators", ss.str()));
+        ss.str("");
+        ss << max_step;
+        arg_vec.push_back(std::make_tuple("max_step", ss.str()));
+        if (adaptive)
+        {
+            ss.str("");
+            ss << min_step;
+            arg_vec.push_back(std::make_tuple("min_step", ss.str()));
+            ss.str("");
+            ss << tol_error;
+            arg_vec.push_back(std::make_tuple("tol_error", ss.str()));
+        }
+        ss.str("");
+        ss << solver;
+        arg_vec.push_back(std::make_tuple("solver", ss.str()));
+#endif
+    }
+
+private:
+    // Constructor parameters
+    std::vector<CTTYPE> numerators, denominators;
+    sc_time max_step, min_step;
+    double tol_error;
+    filter_solver solver;
+    bool adaptive;
+
+    // The kernel holding the states at the local time and at the end
+    // of the step
+    ss_kernel<T,CTTYPE>* kernel;
+    step_control control;
+
+    // The input and output sub-signals
+    basic_sub_signal<T> ival, oval;
+    // The local time, the current step and the size of the next one
+    sc_time tl, h, step;
+
+    //Implementing the abstract semantics
+    void init()
+    {
+        kernel = make_ss_kernel<T,CTTYPE>(numerators, denominators, solver);
+        control = step_control(solver_error_order(solver));
+        tl = SC_ZERO_TIME;
+        step = max_step;
+        set_range(ival, SC_ZERO_TIME, SC_ZERO_TIME);
+    }
 
-        filter1.iport1(inp_sig);
-        filter1.oport1(out_sig);
-        filter1.oport2(smp_sig);
+    void prep()
+    {
+        while (tl >= get_end_time(ival))
+            ival = iport1.read();
+    }
 
-        de2ct1.iport1(out_sig);
-        de2ct1.oport1(oport1);
+    void exec()
+    {
+        const sc_time te = get_end_time(ival);
+        const typename ss_kernel<T,CTTYPE>::input_type u =
+            [this](double th) {return input(tl + h*th);};
+        while (true)
+        {
+            h = std::min(step, te - tl);
+            if (!adaptive)
+            {
+                kernel->step(1, 0, h.to_seconds(), u, NULL);
+                break;
+            }
+            double err_est;
+            kernel->step(1, 0, h.to_seconds(), u, &err_est);
+            bool accepted = err_est < tol_error || h <= min_step;
+            double fac = control.factor(err_est/tol_error, accepted);
+            // A step cut at the end of the input does not grow the next one
+            if (!accepted || h == step || fac < 1)
+                step = std::min(std::max(h*fac, min_step), max_step);
+            if (accepted) break;
+        }
+
+        // The cubic Hermite interpolation of C x over the step
+        double hs = h.to_seconds();
+        T u0 = u(0), u1 = u(1);
+        T y0 = kernel->state_output(0), y1 = kernel->state_output(1);
+        T d0 = kernel->state_output_deriv(0, u0);
+        T d1 = kernel->state_output_deriv(1, u1);
+        basic_poly_shape<T> shape = basic_poly_shape<T>::hermite(tl, hs, y0, y1,
+                                                                 d0, d1);
+        set_range(oval, tl, tl + h);
+
+        // The feed-through of the input
+        double d = kernel->feedthrough();
+        const basic_poly_shape<T>* ishape = get_shape(ival);
+        if (d == 0 || (ishape != NULL && shape.add(*ishape, T(d))))
+            set_shape(oval, shape);
+        else
+        {
+            basic_sub_signal<T> iv = ival;
+            set_function(oval, [shape,iv,d](const sc_time& t)
+                               {
+                                   return shape(t) + d*iv(t);
+                               });
+        }
+        kernel->copy(0, 1);
+        tl += h;
     }
+
+    void prod()
+    {
+        write_multiport(oport1, oval);
+        wait(tl - sc_time_stamp());
+    }
+
+    void clean()
+    {
+        delete kernel;
+    }
+
+    // Samples the input, using the last instant of its range at its end
+    T input(const sc_time& t) const
+    {
+        const sc_time te = get_end_time(ival);
+        return ival(t < te ? t : sc_time::from_value(te.value()-1));
+    }
+
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundInChans.resize(1);     // only one input port
+        boundInChans[0].port = &iport1;
+        boundOutChans.resize(1);    // only one output port
+        boundOutChans[0].port = &oport1;
+    }
+#endif
 };
 
+//! The linear filter of CTTYPE signals
+typedef basic_filter<CTTYPE> filter;
+
 //! Helper function to construct a linear process
 /*! This function is used to construct a CT filter and connect its
  * input and output signals.
@@ -426,8 +630,8 @@ SC_MODULE(filter)
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If>
-inline filter* make_filter(std::string pName,
+template <class OIf, class I1If, class T=typename OIf::value_type>
+inline basic_filter<T>* make_filter(std::string pName,
     const std::vector<CTTYPE> numerators,  ///< Numerator constants
     const std::vector<CTTYPE> denominators,///< Denominator constants
     const sc_time sample_period,            ///< sampling period
@@ -435,7 +639,33 @@ inline filter* make_filter(std::string pName,
     I1If& inp1S
     )
 {
-    auto p = new filter(pName.c_str(), numerators, denominators, sample_period);
+    auto p = new basic_filter<T>(pName.c_str(), numerators, denominators, sample_period);
+
+    (*p).iport1(inp1S);
+    (*p).oport1(outS);
+
+    return p;
+}
+
+//! Helper function to construct a linear process with a chosen solver
+/*! This function is used to construct a CT filter which is integrated
+ * with the given solver and tolerance, and connect its input and output
+ * signals.
+ */
+template <class OIf, class I1If, class T=typename OIf::value_type>
+inline basic_filter<T>* make_filter(std::string pName,
+    const std::vector<CTTYPE> numerators,  ///< Numerator constants
+    const std::vector<CTTYPE> denominators,///< Denominator constants
+    const sc_time max_step,                 ///< Maximum time step
+    const sc_time min_step,                 ///< Minimum time step
+    const double tol_error,                 ///< Tolerated error
+    const filter_solver solver,             ///< Solver of the filter
+    OIf& outS,
+    I1If& inp1S
+    )
+{
+    auto p = new basic_filter<T>(pName.c_str(), numerators, denominators,
+                                 max_step, min_step, tol_error, solver);
 
     (*p).iport1(inp1S);
     (*p).oport1(outS);
@@ -447,42 +677,29 @@ inline filter* make_filter(std::string pName,
 /*! This class is used to build a process which implements a linear
  * in the CT MoC filter with fixed step based on the numerator and
  * denominator constants.
- * It internally uses a DDE filter together with CT2DDEf and DDE2CT
- * MoC interfaces.
+ * It integrates the filter like the filter process, with steps of the
+ * sample period which end at the ends of the input sub-signals.
  */
-SC_MODULE(filterf)
+template <typename T>
+class basic_filterf : public basic_filter<T>
 {
-    CT_in iport1;           ///< port for the input channel
-    CT_out oport1;          ///< port for the output channel;
-
-    CT2DDEf<CTTYPE> ct2de1;
-    DDE::filterf<CTTYPE> filter1;
-    DDE2CT<CTTYPE> de2ct1;
-
-    DDE::DDE2DDE<CTTYPE> inp_sig, out_sig;
-
+public:
     //! The constructor requires the module name and the filter parameters
     /*!
      */
-    filterf(sc_module_name _name,            ///< Process name
-           std::vector<CTTYPE> numerators,  ///< Numerator constants
-           std::vector<CTTYPE> denominators,///< Denominator constants
-           sc_time sample_period             ///< sampling period
-          ) : sc_module(_name), ct2de1("ct2de1", sample_period),
-              filter1("filter1", numerators, denominators),
-              de2ct1("de2ct1", HOLD)
-    {
-        ct2de1.iport1(iport1);
-        ct2de1.oport1(inp_sig);
-
-        filter1.iport1(inp_sig);
-        filter1.oport1(out_sig);
-
-        de2ct1.iport1(out_sig);
-        de2ct1.oport1(oport1);
-    }
+    basic_filterf(sc_module_name _name,            ///< Process name
+                  std::vector<CTTYPE> numerators,  ///< Numerator constants
+                  std::vector<CTTYPE> denominators,///< Denominator constants
+                  sc_time sample_period,           ///< sampling period
+                  filter_solver solver=RK4         ///< Solver of the filter
+                 ) : basic_filter<T>(_name, numerators, denominators,
+                                     sample_period, sample_period, 0, solver,
+                                     false) {}
 };
 
+//! The linear filter with fixed step of CTTYPE signals
+typedef basic_filterf<CTTYPE> filterf;
+
 //! Helper function to construct a linear process with fixed step size
 /*! This function is used to construct a CT filter and connect its
  * input and output signals.
@@ -490,8 +707,8 @@ SC_MODULE(filterf)
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If>
-inline filterf* make_filterf(std::string pName,
+template <class OIf, class I1If, class T=typename OIf::value_type>
+inline basic_filterf<T>* make_filterf(std::string pName,
     const std::vector<CTTYPE> numerators,  ///< Numerator constants
     const std::vector<CTTYPE> denominators,///< Denominator constants
     const sc_time sample_period,            ///< sampling period
@@ -499,7 +716,7 @@ inline filterf* make_filterf(std::string pName,
     I1If& inp1S
     )
 {
-    auto p = new filterf(pName.c_str(), numerators, denominators, sample_period);
+    auto p = new basic_filterf<T>(pName.c_str(), numerators, denominators, sample_period);
 
     (*p).iport1(inp1S);
     (*p).oport1(outS);
@@ -514,8 +731,8 @@ inline filterf* make_filterf(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If>
-inline filter* make_integrator(std::string pName,
+template <class OIf, class I1If, class T=typename OIf::value_type>
+inline basic_filter<T>* make_integrator(std::string pName,
     const sc_time sample_period,            ///< sampling period
     OIf& outS,
     I1If& inp1S
@@ -524,7 +741,7 @@ inline filter* make_integrator(std::string pName,
     std::vector<CTTYPE> numerators = {1.0};
     std::vector<CTTYPE> denominators = {1.0, 0.0};
 
-    auto p = new filter(pName.c_str(), numerators, denominators, sample_period);
+    auto p = new basic_filter<T>(pName.c_str(), numerators, denominators, sample_period);
 
     (*p).iport1(inp1S);
     (*p).oport1(outS);
@@ -539,8 +756,8 @@ inline filter* make_integrator(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class I1If>
-inline filterf* make_integratorf(std::string pName,
+template <class OIf, class I1If, class T=typename OIf::value_type>
+inline basic_filterf<T>* make_integratorf(std::string pName,
     const sc_time sample_period,            ///< sampling period
     OIf& outS,
     I1If& inp1S
@@ -549,7 +766,7 @@ inline filterf* make_integratorf(std::string pName,
     std::vector<CTTYPE> numerators = {1.0};
     std::vector<CTTYPE> denominators = {1.0, 0.0};
 
-    auto p = new filterf(pName.c_str(), numerators, denominators, sample_period);
+    auto p = new basic_filterf<T>(pName.c_str(), numerators, denominators, sample_period);
 
     (*p).iport1(inp1S);
     (*p).oport1(outS);
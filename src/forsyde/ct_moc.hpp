@@ -37,6 +37,10 @@ namespace ForSyDe
 //! The namespace for CT MoC
 /*! This namespace includes constructs used for building models in the
  * continuous-time MoC.
+ * 
+ * The signals, ports and processes carry values of type CTTYPE. Their
+ * basic_ class templates carry other value types, such as a ct_vector
+ * which moves several channels through a single signal.
  */
 namespace CT
 {
@@ -31,56 +31,90 @@ namespace CT
 
 using namespace sc_core;
 
-//! The CT2CT signal used to inter-connect CT processes
-class CT2CT: public ForSyDe::signal<double,sub_signal>
+//! The signals and ports of the CT MoC which carry values of type T
+/*! The types are nested, so that the helper functions of the other MoCs,
+ * which deduce the value type of a signal from its template argument, do
+ * not match the CT signals. They are referred to through the basic_CT2CT,
+ * basic_CT_in and basic_CT_out aliases.
+ */
+template <typename T>
+struct ct_types
 {
-public:
-    CT2CT() : ForSyDe::signal<double,sub_signal>() {}
-    CT2CT(sc_module_name name, unsigned size) : ForSyDe::signal<double,sub_signal>(name, size) {}
+    //! The CT2CT signal used to inter-connect CT processes
+    class CT2CT: public ForSyDe::signal<T,basic_sub_signal<T>>
+    {
+    public:
+        typedef T value_type;
+        CT2CT() : ForSyDe::signal<T,basic_sub_signal<T>>() {}
+        CT2CT(sc_module_name name, unsigned size) : ForSyDe::signal<T,basic_sub_signal<T>>(name, size) {}
+#ifdef FORSYDE_INTROSPECTION
+        
+        virtual std::string moc() const
+        {
+            return "CT";
+        }
+#endif
+    };
+    
+    //! The CT_in port is used for input ports of CT processes
+    class CT_in: public ForSyDe::in_port<T,basic_sub_signal<T>,CT2CT>
+    {
+    public:
+        typedef T value_type;
+        CT_in() : ForSyDe::in_port<T,basic_sub_signal<T>,CT2CT>(){}
+        CT_in(const char* name) : ForSyDe::in_port<T,basic_sub_signal<T>,CT2CT>(name){}
 #ifdef FORSYDE_INTROSPECTION
+        
+        virtual std::string moc() const
+        {
+            return "CT";
+        }
+#endif
+    };
     
-    virtual std::string moc() const
+    //! The CT_out port is used for output ports of CT processes
+    class CT_out: public ForSyDe::out_port<T,basic_sub_signal<T>,CT2CT>
     {
-        return "CT";
-    }
+    public:
+        typedef T value_type;
+        CT_out() : ForSyDe::out_port<T,basic_sub_signal<T>,CT2CT>(){}
+        CT_out(const char* name) : ForSyDe::out_port<T,basic_sub_signal<T>,CT2CT>(name){}
+#ifdef FORSYDE_INTROSPECTION
+        
+        virtual std::string moc() const
+        {
+            return "CT";
+        }
 #endif
+    };
 };
 
+//! The CT signal carrying values of type T
+template <typename T>
+using basic_CT2CT = typename ct_types<T>::CT2CT;
+
+//! The CT input port reading values of type T
+template <typename T>
+using basic_CT_in = typename ct_types<T>::CT_in;
+
+//! The CT output port writing values of type T
+template <typename T>
+using basic_CT_out = typename ct_types<T>::CT_out;
+
+//! The CT2CT signal carries values of the default type CTTYPE
+typedef basic_CT2CT<CTTYPE> CT2CT;
+
 //! The CT::signal is an alias for CT::CT2CT
 using signal = CT2CT;
 
-//! The CT_in port is used for input ports of CT processes
-class CT_in: public ForSyDe::in_port<double,sub_signal,signal>
-{
-public:
-    CT_in() : ForSyDe::in_port<double,sub_signal,signal>(){}
-    CT_in(const char* name) : ForSyDe::in_port<double,sub_signal,signal>(name){}
-#ifdef FORSYDE_INTROSPECTION
-    
-    virtual std::string moc() const
-    {
-        return "CT";
-    }
-#endif
-};
+//! The CT_in port reads values of the default type CTTYPE
+typedef basic_CT_in<CTTYPE> CT_in;
 
 //! The CT::in_port is an alias for CT::CT_in
 using in_port = CT_in;
 
-//! The CT_out port is used for output ports of CT processes
-class CT_out: public ForSyDe::out_port<double,sub_signal,signal>
-{
-public:
-    CT_out() : ForSyDe::out_port<double,sub_signal,signal>(){}
-    CT_out(const char* name) : ForSyDe::out_port<double,sub_signal,signal>(name){}
-#ifdef FORSYDE_INTROSPECTION
-    
-    virtual std::string moc() const
-    {
-        return "CT";
-    }
-#endif
-};
+//! The CT_out port writes values of the default type CTTYPE
+typedef basic_CT_out<CTTYPE> CT_out;
 
 //! The CT::out_port is an alias for CT::CT_out
 using out_port = CT_out;
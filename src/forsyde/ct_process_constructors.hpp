@@ -42,24 +42,32 @@ using namespace sc_core;
  * and one output. The class is parameterized for input and output
  * data-types.
  */
-class comb : public ct_process
+template <typename T0, typename T1>
+class basic_comb : public ct_process
 {
 public:
-    CT_in  iport1;       ///< port for the input channel
-    CT_out oport1;       ///< port for the output channel
+    basic_CT_in<T1>  iport1;     ///< port for the input channel
+    basic_CT_out<T0> oport1;     ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(CTTYPE&,const CTTYPE&)> functype;
+    typedef std::function<void(T0&,const T1&)> functype;
+    
+    //! Type of the optional closed form of the function on sub-signals
+    /*! It sets the shape of the output sub-signal and returns true, or
+     * returns false if it cannot handle the input shape.
+     */
+    typedef std::function<bool(basic_sub_signal<T0>&,const basic_sub_signal<T1>&)> shapetype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
      * applies the user-imlpemented function to it and writes the
      * results using the output port
      */
-    comb(sc_module_name _name,      ///< process name
-         const functype& _func      ///< function to be passed
-         ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
-             _func(_func)
+    basic_comb(sc_module_name _name,      ///< process name
+               const functype& _func,     ///< function to be passed
+               const shapetype& _shape=shapetype() ///< closed form of the function
+               ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
+                   _func(_func), _shape(_shape)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -73,12 +81,15 @@ public:
 
 private:
     // Inputs and output variables
-    sub_signal oval;
-    sub_signal ival1;
+    basic_sub_signal<T0> oval;
+    basic_sub_signal<T1> ival1;
     
     //! The function passed to the process constructor
     functype _func;
     
+    //! The closed form of the function
+    shapetype _shape;
+    
     //Implementing the abstract semantics
     void init() {}
     
@@ -89,11 +100,16 @@ private:
     
     void exec()
     {
-        sub_signal iv1 = ival1;
-        oval = sub_signal(get_start_time(ival1), get_end_time(ival1),
+        if (_shape && _shape(oval, ival1))
+        {
+            set_range(oval, get_start_time(ival1), get_end_time(ival1));
+            return;
+        }
+        basic_sub_signal<T1> iv1 = ival1;
+        oval = basic_sub_signal<T0>(get_start_time(ival1), get_end_time(ival1),
                     [this,iv1](const sc_time& t)
                     {
-                        CTTYPE res;
+                        T0 res;
                         _func(res, iv1(t));
                         return res;
                     }
@@ -119,29 +135,41 @@ private:
 #endif
 };
 
+//! The combinational process with one input and one output of CTTYPE
+typedef basic_comb<CTTYPE,CTTYPE> comb;
+
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-class comb2 : public ct_process
+template <typename T0, typename T1, typename T2>
+class basic_comb2 : public ct_process
 {
 public:
-    CT_in iport1;        ///< port for the input channel 1
-    CT_in iport2;        ///< port for the input channel 2
-    CT_out oport1;        ///< port for the output channel
+    basic_CT_in<T1>  iport1;     ///< port for the input channel 1
+    basic_CT_in<T2>  iport2;     ///< port for the input channel 2
+    basic_CT_out<T0> oport1;     ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(CTTYPE&, const CTTYPE&,
-                                              const CTTYPE&)> functype;
+    typedef std::function<void(T0&, const T1&, const T2&)> functype;
+    
+    //! Type of the optional closed form of the function on sub-signals
+    /*! It sets the shape of the output sub-signal and returns true, or
+     * returns false if it cannot handle the input shapes.
+     */
+    typedef std::function<bool(basic_sub_signal<T0>&,
+                               const basic_sub_signal<T1>&,
+                               const basic_sub_signal<T2>&)> shapetype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
      * applies the user-imlpemented function to them and writes the
      * results using the output port
      */
-    comb2(sc_module_name _name,      ///< process name
-          const functype& _func      ///< function to be passed
-          ) : ct_process(_name), iport1("iport1"), iport2("iport2"), oport1("oport1"),
-              _func(_func)
+    basic_comb2(sc_module_name _name,      ///< process name
+                const functype& _func,     ///< function to be passed
+                const shapetype& _shape=shapetype() ///< closed form of the function
+                ) : ct_process(_name), iport1("iport1"), iport2("iport2"), oport1("oport1"),
+                    _func(_func), _shape(_shape)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -154,9 +182,9 @@ public:
     std::string forsyde_kind() const {return "CT::comb2";}
 private:    
     // Inputs and output sub-signals
-    sub_signal oss;
-    sub_signal iss1;
-    sub_signal iss2;
+    basic_sub_signal<T0> oss;
+    basic_sub_signal<T1> iss1;
+    basic_sub_signal<T2> iss2;
     
     // the current time (local time) and the next time
     sc_time tl, tn;
@@ -166,6 +194,9 @@ private:
     
     //! The function passed to the process constructor
     functype _func;
+    
+    //! The closed form of the function
+    shapetype _shape;
 
     //Implementing the abstract semantics
     void init()
@@ -194,12 +225,18 @@ private:
     
     void exec()
     {
-        sub_signal iv1 = iss1;
-        sub_signal iv2 = iss2;
-        oss = sub_signal(tl, tn, 
+        if (_shape && _shape(oss, iss1, iss2))
+        {
+            set_range(oss, tl, tn);
+            tl = tn;
+            return;
+        }
+        basic_sub_signal<T1> iv1 = iss1;
+        basic_sub_signal<T2> iv2 = iss2;
+        oss = basic_sub_signal<T0>(tl, tn,
                              [iv1,iv2,this](const sc_time& t)
                              {
-                                 CTTYPE res;
+                                 T0 res;
                                  _func(res, iv1(t), iv2(t));
                                  return res;
                              }
@@ -227,27 +264,30 @@ private:
 #endif
 };
 
+//! The combinational process with two inputs and one output of CTTYPE
+typedef basic_comb2<CTTYPE,CTTYPE,CTTYPE> comb2;
+
 //! Process constructor for a combinational process with an array of inputs and one output
 /*! similar to comb but with an array of inputs
  */
-template <std::size_t N>
-class combX : public ct_process
+template <typename T0, typename T1, std::size_t N>
+class basic_combX : public ct_process
 {
 public:
-    std::array<CT_in,N> iport;  ///< port for the input channel array
-    CT_out oport1;              ///< port for the output channel
+    std::array<basic_CT_in<T1>,N> iport; ///< port for the input channel array
+    basic_CT_out<T0> oport1;             ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(CTTYPE&, const std::array<CTTYPE,N>&)> functype;
+    typedef std::function<void(T0&, const std::array<T1,N>&)> functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
      * applies the user-imlpemented function to them and writes the
      * results using the output port
      */
-    combX(sc_module_name _name,      ///< process name
-          const functype& _func      ///< function to be passed
-          ) : ct_process(_name), oport1("oport1"), _func(_func)
+    basic_combX(sc_module_name _name,      ///< process name
+                const functype& _func      ///< function to be passed
+                ) : ct_process(_name), oport1("oport1"), _func(_func)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -260,8 +300,8 @@ public:
     std::string forsyde_kind() const {return "CT::combX";}
 private:    
     // Inputs and output sub-signals
-    sub_signal oss;
-    std::array<sub_signal,N> isss;
+    basic_sub_signal<T0> oss;
+    std::array<basic_sub_signal<T1>,N> isss;
     
     // the current time (local time) and the next time
     sc_time tl, tn;
@@ -277,7 +317,7 @@ private:
     {
         tl = tn = SC_ZERO_TIME;
         std::fill(insT.begin(), insT.end(), SC_ZERO_TIME);
-        for(sub_signal &iss: isss)
+        for(basic_sub_signal<T1> &iss: isss)
             set_range(iss, SC_ZERO_TIME, SC_ZERO_TIME);
     }
     
@@ -296,12 +336,12 @@ private:
     
     void exec()
     {
-        std::array<sub_signal,N> temp_isss = isss;
-        oss = sub_signal(tl, tn, 
+        std::array<basic_sub_signal<T1>,N> temp_isss = isss;
+        oss = basic_sub_signal<T0>(tl, tn,
                              [temp_isss,this](const sc_time& t)
                              {
-                                 CTTYPE res;
-                                 std::array<CTTYPE,N> ivs;
+                                 T0 res;
+                                 std::array<T1,N> ivs;
                                  for (size_t i=0;i<N;i++)
                                     ivs[i] = temp_isss[i](t);
                                  _func(res, ivs);
@@ -331,6 +371,10 @@ private:
 #endif
 };
 
+//! The combinational process with an array of inputs and one output of CTTYPE
+template <std::size_t N>
+using combX = basic_combX<CTTYPE,CTTYPE,N>;
+
 //! Process constructor for a delay element
 /*! This class is used to build a process which delays the input CT signal.
  * It operates by adding the specified delay value to the start and end
@@ -338,21 +382,22 @@ private:
  * 
  * The resulting process does not buffer anything from the signal.
  */
-class delay : public ct_process
+template <typename T>
+class basic_delay : public ct_process
 {
 public:
-    CT_in  iport1;        ///< port for the input channel
-    CT_out oport1;        ///< port for the output channel
+    basic_CT_in<T>  iport1;        ///< port for the input channel
+    basic_CT_out<T> oport1;        ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which inserts the initial element, reads
      * data from its input port, and writes the results using the output
      * port.
      */
-    delay(sc_module_name _name,     ///< process name
-          sc_time delay_time         ///< delay time
-          ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
-              delay_time(delay_time)
+    basic_delay(sc_module_name _name,     ///< process name
+                sc_time delay_time         ///< delay time
+                ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
+                    delay_time(delay_time)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -369,7 +414,7 @@ private:
     sc_time delay_time;
     
     // Inputs and output variables
-    sub_signal val;
+    basic_sub_signal<T> val;
     
     //Implementing the abstract semantics
     void init()
@@ -377,9 +422,7 @@ private:
         if (delay_time > SC_ZERO_TIME)
         {
             write_multiport(oport1, 
-                sub_signal(SC_ZERO_TIME, delay_time, 
-                    [](const sc_time& t){return 0;}
-                )
+                basic_sub_signal<T>(SC_ZERO_TIME, delay_time, basic_poly_shape<T>())
             );
             wait(delay_time);
         }
@@ -415,25 +458,29 @@ private:
 #endif
 };
 
+//! The delay element of CTTYPE signals
+typedef basic_delay<CTTYPE> delay;
+
 //! Process constructor for a shift element
 /*! This class is used to build a process which shifts the shape of the
  * input signal by a given value to the right.
  */
-class shift : public ct_process
+template <typename T>
+class basic_shift : public ct_process
 {
 public:
-    CT_in  iport1;       ///< port for the input channel
-    CT_out oport1;       ///< port for the output channel
+    basic_CT_in<T>  iport1;       ///< port for the input channel
+    basic_CT_out<T> oport1;       ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which inserts the initial element, reads
      * data from its input port, and writes the results using the output
      * port.
      */
-    shift(sc_module_name _name,     ///< process name
-          sc_time delay_time         ///< delay time
-          ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
-              delay_time(delay_time)
+    basic_shift(sc_module_name _name,     ///< process name
+                sc_time delay_time         ///< delay time
+                ) : ct_process(_name), iport1("iport1"), oport1("oport1"),
+                    delay_time(delay_time)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -450,7 +497,7 @@ private:
     sc_time delay_time;
     
     // Inputs and output variables
-    sub_signal val;
+    basic_sub_signal<T> val;
     
     //Implementing the abstract semantics
     void init()
@@ -458,9 +505,7 @@ private:
         if (delay_time > SC_ZERO_TIME)
         {
             write_multiport(oport1, 
-                sub_signal(SC_ZERO_TIME, delay_time, 
-                    [](const sc_time& t){return 0;}
-                )
+                basic_sub_signal<T>(SC_ZERO_TIME, delay_time, basic_poly_shape<T>())
             );
             wait(delay_time);
         }
@@ -475,9 +520,16 @@ private:
     {
         set_range(val, get_start_time(val)+delay_time,
                        get_end_time(val)+delay_time);
-        sub_signal v = val;
-        set_function(val, [v,this](const sc_time& t){
-                return get_function(v)(t-delay_time);
+        if (const basic_poly_shape<T>* shape = get_shape(val))
+        {
+            basic_poly_shape<T> s = *shape;
+            s.shift(delay_time.to_seconds());
+            set_shape(val, s);
+            return;
+        }
+        auto f = get_function(val);
+        set_function(val, [f,this](const sc_time& t){
+                return f(t-delay_time);
             }
         );
     }
@@ -501,26 +553,30 @@ private:
 #endif
 };
 
+//! The shift element of CTTYPE signals
+typedef basic_shift<CTTYPE> shift;
+
 //! Process constructor for a constant source process
 /*! This class is used to build a souce process with constant output.
  * Its main purpose is to be used in test-benches.
  * 
  * This class can directly be instantiated to build a process.
  */
-class constant : public ct_process
+template <typename T>
+class basic_constant : public ct_process
 {
 public:
-    CT_out oport1;            ///< port for the output channel
+    basic_CT_out<T> oport1;            ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which runs the user-imlpemented function
      * and writes the result using the output port
      */
-    constant(sc_module_name _name,      ///< The module name
-              CTTYPE init_val,          ///< The constant output value
-              sc_time end_time           ///< The end time of the signal
-             ) : ct_process(_name), oport1("oport1"),
-                 init_val(init_val)
+    basic_constant(sc_module_name _name,      ///< The module name
+                   T init_val,                ///< The constant output value
+                   sc_time end_time           ///< The end time of the signal
+                  ) : ct_process(_name), oport1("oport1"),
+                 init_val(init_val), end_time(end_time)
                  
     {
 #ifdef FORSYDE_INTROSPECTION
@@ -537,14 +593,14 @@ public:
     std::string forsyde_kind() const {return "CT::constant";}
     
 private:
-    CTTYPE init_val;
+    T init_val;
     sc_time end_time;
     
     //Implementing the abstract semantics
     void init()
     {
-        auto ss = sub_signal(sc_time(0,SC_NS), end_time, 
-                        [this](const sc_time& t){return init_val;}
+        auto ss = basic_sub_signal<T>(sc_time(0,SC_NS), end_time, 
+                        basic_poly_shape<T>::constant(init_val)
                   );
         write_multiport(oport1, ss);
         wait(get_end_time(ss) - sc_time_stamp());
@@ -570,6 +626,9 @@ private:
 #endif
 };
 
+//! The constant source of CTTYPE signals
+typedef basic_constant<CTTYPE> constant;
+
 //! Process constructor for a source process
 /*! This class is used to build a souce process which only has an output.
  * Given a function, the process generates a source process which
@@ -577,23 +636,24 @@ private:
  * start and end times of the signals should aso be mentioned.
  * 
  */
-class source : public ct_process
+template <typename T>
+class basic_source : public ct_process
 {
 public:
-    CT_out oport1;        ///< port for the output channel
+    basic_CT_out<T> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(CTTYPE&, const sc_time&)> functype;
+    typedef std::function<void(T&, const sc_time&)> functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which runs the user-imlpemented function
      * and writes the result using the output port
      */
-    source(sc_module_name _name,   ///< The module name
-           functype _func,         ///< function to be passed
-           const sc_time& end_time ///< End time
-          ) : ct_process(_name), oport1("oport1"),
-              _func(_func), end_time(end_time)
+    basic_source(sc_module_name _name,   ///< The module name
+                 functype _func,         ///< function to be passed
+                 const sc_time& end_time ///< End time
+                ) : ct_process(_name), oport1("oport1"),
+                    _func(_func), end_time(end_time)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -605,6 +665,22 @@ public:
 #endif
     }
     
+    //! The constructor for sources with a closed-form shape
+    /*! The shape is evaluated without calling a function object.
+     */
+    basic_source(sc_module_name _name,   ///< The module name
+                 const basic_poly_shape<T>& shape,///< shape of the signal
+                 const sc_time& end_time ///< End time
+                ) : ct_process(_name), oport1("oport1"),
+                    shape(shape), end_time(end_time)
+    {
+#ifdef FORSYDE_INTROSPECTION
+        std::stringstream ss;
+        ss << end_time;
+        arg_vec.push_back(std::make_tuple("end_time", ss.str()));
+#endif
+    }
+    
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::source";}
     
@@ -612,19 +688,23 @@ private:
     //! The function passed to the process constructor
     functype _func;
     
+    //! The shape used if there is no function
+    basic_poly_shape<T> shape;
+    
     sc_time end_time;        // The end time    
     
     //Implementing the abstract semantics
     void init()
     {
-        auto ss = sub_signal(sc_time(0,SC_NS), end_time,
+        auto ss = _func ? basic_sub_signal<T>(sc_time(0,SC_NS), end_time,
                                 [this](const sc_time& t)
                                 {
-                                    CTTYPE res=0;
+                                    T res = T();
                                     _func(res, t);
                                     return res;
                                 }
-                            );
+                            )
+                        : basic_sub_signal<T>(sc_time(0,SC_NS), end_time, shape);
         write_multiport(oport1, ss);
         wait(get_end_time(ss) - sc_time_stamp());
     }
@@ -649,28 +729,32 @@ private:
 #endif
 };
 
+//! The source of CTTYPE signals
+typedef basic_source<CTTYPE> source;
+
 //! Process constructor for a sink process
 /*! This class is used to build a sink process which only has an input.
  * Its main purpose is to be used in test-benches. The process repeatedly
  * applies a given function to the current input using a sampling time.
  */
-class sink : public ct_process
+template <typename T>
+class basic_sink : public ct_process
 {
 public:
-    CT_in iport1;         ///< port for the input channel
+    basic_CT_in<T> iport1;         ///< port for the input channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(const CTTYPE&)> functype;
+    typedef std::function<void(const T&)> functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which runs the user-imlpemented function
      * in each cycle.
      */
-    sink(sc_module_name _name,      ///< process name
-         functype _func,           ///< function to be passed
-         sc_time sampling_period    ///< the output sampling period
-        ) : ct_process(_name), iport1("iport1"), _func(_func),
-            sampling_period(sampling_period)
+    basic_sink(sc_module_name _name,      ///< process name
+               functype _func,           ///< function to be passed
+               sc_time sampling_period    ///< the output sampling period
+              ) : ct_process(_name), iport1("iport1"), _func(_func),
+                  sampling_period(sampling_period)
             
     {
 #ifdef FORSYDE_INTROSPECTION
@@ -684,7 +768,7 @@ public:
     std::string forsyde_kind() const {return "CT::sink";}
     
 private:
-    sub_signal val;         // The current read sub_signal
+    basic_sub_signal<T> val;         // The current read sub_signal
     sc_time cur_time;        // The current time used for sampling
 
     //! The function passed to the process constructor
@@ -723,6 +807,24 @@ private:
 #endif
 };
 
+//! The sink of CTTYPE signals
+typedef basic_sink<CTTYPE> sink;
+
+//! Writes a traced value as one column
+template <typename T>
+inline void trace_value(std::ostream& os, const T& val)
+{
+    os << val;
+}
+
+//! Writes the elements of a traced vector value as separate columns
+template <typename T, std::size_t N>
+inline void trace_value(std::ostream& os, const ct_vector<T,N>& val)
+{
+    for (std::size_t i=0; i<N; i++)
+        os << (i ? " " : "") << val[i];
+}
+
 //! Process constructor for a trace process
 /*! This class is used to build a sink process which only has an input.
  * Its main purpose is to be used in test-benches.
@@ -730,19 +832,20 @@ private:
  * The resulting process prints the sampled data as a trace in an output
  * ".dat" file which can be plotted using gaw or gwave.
  */
-class traceSig : public ct_process
+template <typename T>
+class basic_traceSig : public ct_process
 {
 public:
-    CT_in  iport1;       ///< port for the input channel
+    basic_CT_in<T>  iport1;       ///< port for the input channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which runs the user-imlpemented function
      * in each cycle.
      */
-    traceSig(sc_module_name _name,          ///< Process name
-             const sc_time& sample_period   ///< Sampling time
-             ) : ct_process(_name), iport1("iport1"),
-                 sample_period(sample_period)
+    basic_traceSig(sc_module_name _name,          ///< Process name
+                   const sc_time& sample_period   ///< Sampling time
+                   ) : ct_process(_name), iport1("iport1"),
+                       sample_period(sample_period)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -759,7 +862,7 @@ private:
     
     // The internal variables
     std::ofstream outFile;
-    sub_signal in_val;
+    basic_sub_signal<T> in_val;
     sc_time curTime;
     
     //Implementing the abstract semantics
@@ -782,8 +885,9 @@ private:
     
     void prod()
     {
-        outFile << curTime.to_seconds() << " " << in_val(curTime)
-                << std::endl;
+        outFile << curTime.to_seconds() << " ";
+        trace_value(outFile, in_val(curTime));
+        outFile << std::endl;
         curTime += sample_period;
     }
     
@@ -801,6 +905,9 @@ private:
 #endif
 };
 
+//! The trace process of CTTYPE signals
+typedef basic_traceSig<CTTYPE> traceSig;
+
 //! Process constructor for a fan-out process with one input and one output
 /*! This class is used to build a fanout processes with one input
  * and one output. The class is parameterized for input and output
@@ -811,48 +918,46 @@ private:
  * designs). It will be used when it is needed to connect an input
  * port of a module to the input channels of multiple processes (modules).
  */
-class fanout : public ct_process
+template <typename T>
+class basic_fanout : public ct_process
 {
 public:
-    CT_in iport1;        ///< port for the input channel
-    CT_out oport1;       ///< port for the output channel
+    basic_CT_in<T> iport1;        ///< port for the input channel
+    basic_CT_out<T> oport1;       ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
      * applies and writes the results using the output port
      */
-    fanout(sc_module_name _name)  // module name
-         : ct_process(_name) { }
+    basic_fanout(sc_module_name _name)  // module name
+               : ct_process(_name) { }
     
     //! Specifying from which process constructor is the module built
     std::string forsyde_kind() const {return "CT::fanout";}
     
 private:
-    // Inputs and output variables
-    sub_signal* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const basic_sub_signal<T>> val;
     
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new sub_signal;
-    }
+    void init() {}
     
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
         wait(get_end_time(*val) - sc_time_stamp());
     }
     
     void clean()
     {
-        delete val;
+        val.reset();
     }
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
@@ -865,6 +970,9 @@ private:
 #endif
 };
 
+//! The fan-out process of CTTYPE signals
+typedef basic_fanout<CTTYPE> fanout;
+
 }
 }
 
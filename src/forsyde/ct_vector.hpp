@@ -0,0 +1,144 @@
+/**********************************************************************
+    * ct_vector.hpp -- Fixed-width vectors of values for CT signals   *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Representing several channels of a CT signal as one    *
+    *          value.                                                 *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef CT_VECTOR_HPP
+#define CT_VECTOR_HPP
+
+/*! \file ct_vector.hpp
+ * \brief Implements the fixed-width vector values of multi-channel signals
+ *
+ *  This file includes a vector type with element-wise arithmetic which
+ * can be used as the value type of the CT MoC, so that a multi-channel
+ * signal moves through a network as a single signal. The elements are
+ * stored in an aligned array and the operators are fixed-length loops,
+ * which the compilers vectorize with the SIMD instructions of the target.
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+namespace ForSyDe
+{
+
+//! The alignment of a vector of the given size in bytes
+constexpr std::size_t ct_vector_align(std::size_t size, std::size_t align)
+{
+    return size % 32 == 0 ? 32 : size % 16 == 0 ? 16 : align;
+}
+
+//! A fixed-width vector of N values of type T
+/*! The arithmetic operators work element-wise, and a scalar operand is
+ * applied to all elements. A scalar converts implicitly to a vector with
+ * all elements equal to it.
+ */
+template <typename T, std::size_t N>
+struct alignas(ct_vector_align(sizeof(T)*N, alignof(T))) ct_vector
+{
+    T v[N];
+
+    //! The zero vector
+    ct_vector()
+    {
+        for (std::size_t i=0; i<N; i++) v[i] = T();
+    }
+
+    //! A vector with all elements equal to s
+    ct_vector(const T& s)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] = s;
+    }
+
+    T& operator[](std::size_t i) {return v[i];}
+    const T& operator[](std::size_t i) const {return v[i];}
+
+    static constexpr std::size_t size() {return N;}
+
+    T* begin() {return v;}
+    T* end() {return v+N;}
+    const T* begin() const {return v;}
+    const T* end() const {return v+N;}
+
+    ct_vector& operator+=(const ct_vector& o)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] += o.v[i];
+        return *this;
+    }
+    ct_vector& operator-=(const ct_vector& o)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] -= o.v[i];
+        return *this;
+    }
+    ct_vector& operator*=(const ct_vector& o)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] *= o.v[i];
+        return *this;
+    }
+    ct_vector& operator/=(const ct_vector& o)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] /= o.v[i];
+        return *this;
+    }
+    ct_vector& operator*=(const T& s)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] *= s;
+        return *this;
+    }
+    ct_vector& operator/=(const T& s)
+    {
+        for (std::size_t i=0; i<N; i++) v[i] /= s;
+        return *this;
+    }
+
+    friend ct_vector operator+(ct_vector a, const ct_vector& b) {return a += b;}
+    friend ct_vector operator-(ct_vector a, const ct_vector& b) {return a -= b;}
+    friend ct_vector operator*(ct_vector a, const ct_vector& b) {return a *= b;}
+    friend ct_vector operator/(ct_vector a, const ct_vector& b) {return a /= b;}
+    friend ct_vector operator*(ct_vector a, const T& s) {return a *= s;}
+    friend ct_vector operator*(const T& s, ct_vector a) {return a *= s;}
+    friend ct_vector operator/(ct_vector a, const T& s) {return a /= s;}
+
+    friend ct_vector operator-(ct_vector a)
+    {
+        for (std::size_t i=0; i<N; i++) a.v[i] = -a.v[i];
+        return a;
+    }
+
+    friend bool operator==(const ct_vector& a, const ct_vector& b)
+    {
+        for (std::size_t i=0; i<N; i++)
+            if (!(a.v[i] == b.v[i])) return false;
+        return true;
+    }
+    friend bool operator!=(const ct_vector& a, const ct_vector& b) {return !(a == b);}
+
+    //! The largest magnitude of the elements
+    friend T norm_inf(const ct_vector& a)
+    {
+        T m = T();
+        for (std::size_t i=0; i<N; i++) m = std::max(m, T(std::abs(a.v[i])));
+        return m;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ct_vector& a)
+    {
+        os << "[";
+        for (std::size_t i=0; i<N; i++) os << (i ? " " : "") << a.v[i];
+        return os << "]";
+    }
+};
+
+}
+
+#endif
@@ -191,12 +191,7 @@ private:
         
         // FIXME: res = outputRow(fmu, c, time, file, separator, fmi2False); // output values for this step
         auto res = getRealOutput(&fmu, c, output_index);
-        oval = sub_signal(time, time+h,
-                    [this,res](const sc_time& t)
-                    {
-                        return res;
-                    }
-               );
+        oval = sub_signal(time, time+h, poly_shape::constant(res));
     }
     
     void prod()
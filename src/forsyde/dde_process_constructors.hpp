@@ -30,6 +30,7 @@
 
 #include "tt_event.hpp"
 #include "dde_process.hpp"
+#include "state_space.hpp"
 
 namespace ForSyDe
 {
@@ -106,9 +107,9 @@ private:
     void prod()
     {
         auto oev = ttn_event<T0>(*oval, get_time(*iev1));
-        write_multiport(oport1, oev);
+        write_multiport(oport1, std::move(oev));
         // synchronization with kernel time
-        wait(get_time(oev) - sc_time_stamp());
+        wait(get_time(*iev1) - sc_time_stamp());
     }
 
     void clean()
@@ -304,7 +305,7 @@ private:
     {
         ev = new ttn_event<T>;
         auto oev = ttn_event<T>(init_val, SC_ZERO_TIME);
-        write_multiport(oport1, oev);
+        write_multiport(oport1, std::move(oev));
         wait(SC_ZERO_TIME);
     }
 
@@ -606,6 +607,20 @@ private:
 //! Process constructor for implementing a linear filter
 /*! This class is used to build a process which implements a linear filter
  * based on the numerator and denominator constants.
+ *
+ * In each step, the filter requests the samples of its input at the
+ * instants used by its solver through the sampling port, and commits the
+ * step if its estimated error is below tol_error.
+ *
+ * With the default RK4 solver, the filter keeps its original behavior:
+ * it requests samples at the middle and the end of steps of max_step,
+ * compares a full step with two half steps, and commits an accepted step
+ * at its middle. A rejected step is retried with the same samples. With
+ * the other solvers, an accepted step is committed at its end, the input
+ * is interpolated linearly between the samples, and the next step is
+ * sized by a PI controller between min_step and max_step.
+ * Filters of orders up to FORSYDE_FIXED_FILTER_ORDER are integrated with
+ * a fixed-size kernel which does not allocate memory in the steps.
  */
 template <class T>
 class filter : public dde_process
@@ -615,8 +630,6 @@ public:
     DDE_out<T> oport1;           ///< port for the output channel
     DDE_out<unsigned int> oport2;///< port for the sampling signal
 
-    typedef matrix<T> MatrixDouble;
-
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which inserts the initial element, reads
      * data from its input port, and writes the results using the output
@@ -627,10 +640,12 @@ public:
             std::vector<T> denominators,     ///< Denominator constants
             sc_time max_step,                ///< Maximum time step
             sc_time min_step=sc_time(0.05,SC_NS),///< Minimum time step
-            T tol_error=1e-5                 ///< Tolerated error
+            typename ss_lanes<T>::value_type tol_error=1e-5, ///< Tolerated error
+            filter_solver solver=RK4         ///< Solver of the filter
           ) : dde_process(_name), iport1("iport1"), oport1("oport1"),
               numerators(numerators), denominators(denominators),
-              max_step(max_step), min_step(min_step), tol_error(tol_error)
+              max_step(max_step), min_step(min_step), tol_error(tol_error),
+              solver(solver)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -648,6 +663,9 @@ public:
         ss.str("");
         ss << tol_error;
         arg_vec.push_back(std::make_tuple("tol_error", ss.str()));
+        ss.str("");
+        ss << solver;
+        arg_vec.push_back(std::make_tuple("solver", ss.str()));
 #endif
     }
 
@@ -658,21 +676,22 @@ private:
     // Constructor parameters
     std::vector<T> numerators, denominators;
     sc_time max_step, min_step;
-    T tol_error;
+    typename ss_lanes<T>::value_type tol_error;
+    filter_solver solver;
 
     // Internal variables
     sc_time step;
     sc_time samplingTimeTag;
-    MatrixDouble a, b, c, d;
-    // states
-    MatrixDouble x, x0, x1, x2;
-    // current and previous input/time.
-    MatrixDouble u, u0, u1, u_1;
-    sc_time t, t_1, t2, h;
-    // output
-    MatrixDouble y0, y1, y2;
-    // Some helper matrices used in RK solver
-    MatrixDouble k1,k2,k3,k4;
+    // the committed time and input
+    sc_time t_1;
+    T u_1;
+    // the input samples of the current step and their times
+    std::vector<T> us;
+    std::vector<sc_time> ts;
+    // The kernel holding the committed state in slot 0 and the candidate
+    // states in the others
+    ss_kernel<T>* kernel;
+    step_control control;
     // to prevent rounding error
     double roundingFactor;
 
@@ -684,81 +703,71 @@ private:
     {
         out_ev = new ttn_event<T>;
 
+        kernel = make_ss_kernel<T>(numerators, denominators, solver);
+        control = step_control(solver_error_order(solver));
         step = max_step;
-        int /*nn = nums.size(),*/ nd = denominators.size();
-        a = MatrixDouble(nd-1,nd-1);
-        b = MatrixDouble(nd-1,1);
-        c = MatrixDouble(1,nd-1);
-        d = MatrixDouble(1,1);
-
-        tf2ss(numerators,denominators,a,b,c,d);
-
-        // State number
-        int numState = a.size1();
-        assert(a.size1() == a.size2());
-        samplingTimeTag = SC_ZERO_TIME;
-        x = zero_matrix<T>(numState,1);
-        u = MatrixDouble(1,1), u_1 = MatrixDouble(1,1);
-        u0 = u1 = MatrixDouble(1,1);
-        y1 = MatrixDouble(1,1);
-        k1 = MatrixDouble(numState,1);
-        k2 = MatrixDouble(numState,1);
-        k3 = MatrixDouble(numState,1);
-        k4 = MatrixDouble(numState,1);
+        us.resize(solver_nodes(solver).size());
+        ts.resize(us.size());
 
         // initial sampling time tag
+        samplingTimeTag = SC_ZERO_TIME;
         write_multiport(oport2,ttn_event<unsigned int>(0, samplingTimeTag));
         // read initial input
         auto in_ev = iport1.read();
-        u(0,0) = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-null inputs
-        t = get_time(in_ev);
+        u_1 = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-null inputs
+        t_1 = get_time(in_ev);
         // calculate and write initial output
-        y1 = boost::numeric::ublas::prod(c,x) + boost::numeric::ublas::prod(d,u);
-        *out_ev = ttn_event<T>(y1(0,0), t);
+        *out_ev = ttn_event<T>(kernel->output(0, u_1), t_1);
         write_multiport(oport1, *out_ev);
         // step signal
-        write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step/2));
-        write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step));
-        u_1(0,0) = u(0,0);
-        t_1 = t;
+        request_samples();
         roundingFactor = 1.0001;
     }
 
     void prep()
     {
-        auto in_ev = iport1.read();
-        u1(0,0) = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-null inputs
-        t = get_time(in_ev);
-
-        in_ev = iport1.read();
-        u0(0,0) = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-null inputs
-        t2 = get_time(in_ev);
+        us[0] = u_1;
+        ts[0] = t_1;
+        for (unsigned i=1; i<us.size(); i++)
+        {
+            auto in_ev = iport1.read();
+            us[i] = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-null inputs
+            ts[i] = get_time(in_ev);
+        }
     }
 
     void exec()
     {
-        // 1st step error estimation
-        h = t - t_1;
-        rkSolver(a, b, c, d, u1, u_1, x, h.to_seconds(), x1, y1);
+        if (solver == RK4) exec_rk4(); else exec_adaptive();
+    }
 
+    // The original step, which compares a step with two half steps
+    void exec_rk4()
+    {
+        const T &u1 = us[1], &u0 = us[2];
+        sc_time t = ts[1], t2 = ts[2];
+        // 1st step error estimation
+        sc_time h = t - t_1;
+        kernel->step(2, 0, h.to_seconds(),
+                     [&](double th) {return linear_input(u_1, u1, th);}, NULL);
         // regular RK
         h = t2 - t_1;
-        rkSolver(a, b, c, d, u0, u_1, x, h.to_seconds(), x0, y0);
-
+        T y0 = kernel->step(1, 0, h.to_seconds(),
+                            [&](double th) {return linear_input(u_1, u0, th);}, NULL);
         // 2nd step error estimation
-        rkSolver(a, b, c, d, u0, u1, x1, (h/2).to_seconds(), x2, y2);
+        T y2 = kernel->step(3, 2, (h/2).to_seconds(),
+                            [&](double th) {return linear_input(u1, u0, th);}, NULL);
 
         // error estimation
-        double err_est = (double) std::abs(y2(0,0)-y0(0,0))/(h.to_seconds());
+        double err_est = (double) norm_inf(y2-y0)/(h.to_seconds());
         if( (err_est < tol_error) || (h<=roundingFactor*min_step)) {
-          x = x0;
+          kernel->copy(0, 1);
           samplingTimeTag = t;
           // TODO: move the following line to the prod stage
           write_multiport(oport2, ttn_event<unsigned int>(1, samplingTimeTag)); // commitment
-          *out_ev = ttn_event<T>(y0(0,0), t);
+          *out_ev = ttn_event<T>(y0, t);
           write_multiport(oport1, *out_ev);
-          u(0,0) = u0(0,0);
-          u_1(0,0) = u(0,0);
+          u_1 = u0;
           t_1 = t;
           if(h==min_step)
             std::cout << "Step accepted due to minimum step size. "
@@ -766,102 +775,66 @@ private:
         }
     }
 
+    // A step with an embedded error estimate and step size control
+    void exec_adaptive()
+    {
+        sc_time h = ts.back() - t_1;
+        double err_est;
+        T y = kernel->step(1, 0, h.to_seconds(),
+                           [this](double th) {return input(th);}, &err_est);
+
+        // step size control
+        bool accepted = (err_est < tol_error) || (h<=roundingFactor*min_step);
+        step = h * control.factor(err_est/tol_error, accepted);
+        step = std::min(std::max(step, min_step), max_step);
+        if (accepted) {
+          kernel->copy(0, 1);
+          t_1 = ts.back();
+          u_1 = us.back();
+          samplingTimeTag = t_1;
+          // TODO: move the following line to the prod stage
+          write_multiport(oport2, ttn_event<unsigned int>(1, t_1)); // commitment
+          *out_ev = ttn_event<T>(y, t_1);
+          write_multiport(oport1, *out_ev);
+          if(err_est >= tol_error)
+            std::cout << "Step accepted due to minimum step size. "
+             << "However, err_tol is not met." << std::endl;
+        }
+    }
+
     void prod()
     {
-        write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step/2));
-        write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step));
+        request_samples();
     }
 
     void clean()
     {
         delete out_ev;
+        delete kernel;
     }
 
-    // To obtain state space matrices from transfer function.
-    // We assume there are non-zero leading coefficients in num and denom.
-    int tf2ss(std::vector<T> & num_, std::vector<T> & den_, MatrixDouble & a,
-          MatrixDouble & b, MatrixDouble & c, MatrixDouble & d)
+    // Requests the input samples of the next step
+    void request_samples()
     {
-        std::vector<T> num, den;
-        // sizes checking
-        int nn = num_.size(), nd = den_.size();
-        if(nn >= nd)
-        {
-            std::cerr << "ERROR: " << "degree(num) = " << nn
-            << " >= degree(denom) = " << nd << std::endl;
-            abort();
-        }
-        T dCoef1 = den_.at(0);
-        if(nd==1)
+        const std::vector<double>& nodes = solver_nodes(solver);
+        if (solver == RK4)
         {
-            //~ a = NULL, b = NULL, c = NULL;
-            d = MatrixDouble(1,1);
-            d(0,0) = num_.at(0)/dCoef1;
+            write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step/2));
+            write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step));
         }
         else
-        {
-            if ((nd - nn) > 0)
-            {
-                // Pad num so that degree(num) == degree(denom)
-                for(int i=0; i<nd; i++)
-                {
-                    if(i<(nd-nn))
-                        num.push_back(0.0);
-                    else
-                        num.push_back(num_.at(i-nd+nn));
-                }
-            }
-
-            // Normalizing w.r.t the leading coefficient of denominator
-            for(unsigned int i=0; i<num.size(); i++)
-                num.at(i) /= dCoef1;
-            for(unsigned int i=0; i<den_.size(); i++)
-                den_.at(i) /= dCoef1;
-            for(unsigned int i=0; i<(den_.size()-1); i++)
-                den.push_back(den_.at(i+1));
-
-            // Form A (nd-1)*(nd-1)
-            a = zero_matrix<T> (a.size1(), a.size2());
-            if(nd > 2)
-            {
-                // The eyes (up-right corner) are set to '1'
-                for(int i=0; i<(nd-2); i++)
-                    for(int j=0; j<(nd-1); j++)
-                        if((j-i)==1) a(i,j) = 1.0;
-                // The lower row(s)
-                for(int j=0; j<(nd-1); j++)
-                    a(nd-2,j) = 0-den.at(nd-2-j);
-            }
-            else
-                a(0,0) = 0-den.at(0);
-            //
-            // Form B (nd-1)*1
-            b = zero_matrix<T> (b.size1(), b.size2());
-            b(nd-2,0) = 1.0;
-            //
-            // Form C 1*(nd-1)
-            for(int j=0; j< nd-1; j++)
-                c(0,nd-2-j) = num.at(j+1) - num.at(0)*den.at(j);
-            //
-            // Form D 1*1
-            d(0,0) = num.at(0);
-        }
-
-        return 0;
+            for (unsigned i=1; i<nodes.size(); i++)
+                write_multiport(oport2, ttn_event<unsigned int>(0, samplingTimeTag+step*nodes[i]));
     }
 
-    void rkSolver(MatrixDouble a, MatrixDouble b, MatrixDouble c,
-                  MatrixDouble d, MatrixDouble u_k, MatrixDouble u_k_1,
-                  MatrixDouble x, T h, MatrixDouble &x_, MatrixDouble &y)
+    // Interpolates the input samples linearly at the fraction th of the step
+    T input(double th) const
     {
-        // Some helper matrices used in RK solver
-        MatrixDouble k1,k2,k3,k4;
-        k1 = boost::numeric::ublas::prod(a,x) + boost::numeric::ublas::prod(b,u_k_1);
-        k2 = boost::numeric::ublas::prod(a,(x+k1*(h/2.0))) + boost::numeric::ublas::prod(b,(u_k_1 + u_k)) * 0.5;
-        k3 = boost::numeric::ublas::prod(a,(x+k2*(h/2.0))) + boost::numeric::ublas::prod(b,(u_k_1 + u_k)) * 0.5;
-        k4 = boost::numeric::ublas::prod(a,(x+k3*h)) + boost::numeric::ublas::prod(b,u_k);
-        x_ = x + (k1 + 2.0*k2 + 2.0*k3 + k4) * (h/6.0);
-        y = boost::numeric::ublas::prod(c,x_) + boost::numeric::ublas::prod(d,u_k);
+        const std::vector<double>& nodes = solver_nodes(solver);
+        unsigned i = 1;
+        while (i+1 < nodes.size() && nodes[i] < th) i++;
+        double r = (th - nodes[i-1])/(nodes[i] - nodes[i-1]);
+        return us[i-1] + r*(us[i] - us[i-1]);
     }
 
 #ifdef FORSYDE_INTROSPECTION
@@ -876,9 +849,48 @@ private:
 #endif
 };
 
+//! Process constructor for implementing a bank of linear filters
+/*! This class is used to build a process which implements N linear
+ * filters of the same order, each with its own numerator and denominator
+ * constants. The tokens carry the values of all filters in a ct_vector.
+ *
+ * The filters are integrated in lockstep with their states laid out as a
+ * structure of arrays, so each operation of the solver is applied to all
+ * filters at once, and the steps are controlled by the largest error
+ * among them. It replaces N filter processes and their channels.
+ */
+template <class T, std::size_t N>
+class filter_bank : public filter<ct_vector<T,N>>
+{
+public:
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which inserts the initial element, reads
+     * data from its input port, and writes the results using the output
+     * port.
+     */
+    filter_bank(sc_module_name _name,            ///< process name
+                const std::vector<std::vector<T>>& numerators,  ///< Numerator constants of the filters
+                const std::vector<std::vector<T>>& denominators,///< Denominator constants of the filters
+                sc_time max_step,                ///< Maximum time step
+                sc_time min_step=sc_time(0.05,SC_NS),///< Minimum time step
+                double tol_error=1e-5,           ///< Tolerated error
+                filter_solver solver=RK4         ///< Solver of the filters
+               ) : filter<ct_vector<T,N>>(_name,
+                                          interleave_coefs<T,N>(numerators, true),
+                                          interleave_coefs<T,N>(denominators, false),
+                                          max_step, min_step, tol_error, solver) {}
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "DDE::filter_bank";}
+};
+
 //! Process constructor for implementing a linear filter with fixed step size
 /*! This class is used to build a process which implements a linear filter
  * with fixed step size based on the numerator and denominator constants.
+ *
+ * The input is interpolated linearly between the consecutive samples.
+ * Filters of orders up to FORSYDE_FIXED_FILTER_ORDER are integrated with
+ * a fixed-size kernel which does not allocate memory in the steps.
  */
 template <class T>
 class filterf : public dde_process
@@ -887,8 +899,6 @@ public:
     DDE_in<T>  iport1;           ///< port for the input channel
     DDE_out<T> oport1;           ///< port for the output channel
 
-    typedef matrix<T> MatrixDouble;
-
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which inserts the initial element, reads
      * data from its input port, and writes the results using the output
@@ -896,9 +906,11 @@ public:
      */
     filterf(sc_module_name _name,           ///< process name
             std::vector<T> numerators,      ///< Numerator constants
-            std::vector<T> denominators     ///< Denominator constants
+            std::vector<T> denominators,    ///< Denominator constants
+            filter_solver solver=RK4        ///< Solver of the filter
           ) : dde_process(_name), iport1("iport1"), oport1("oport1"),
-              numerators(numerators), denominators(denominators)
+              numerators(numerators), denominators(denominators),
+              solver(solver)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -907,6 +919,9 @@ public:
         ss.str("");
         ss << denominators;
         arg_vec.push_back(std::make_tuple("denominators", ss.str()));
+        ss.str("");
+        ss << solver;
+        arg_vec.push_back(std::make_tuple("solver", ss.str()));
 #endif
     }
 
@@ -916,18 +931,13 @@ public:
 private:
     // Constructor parameters
     std::vector<T> numerators, denominators;
+    filter_solver solver;
 
-    // Internal variables
-    MatrixDouble a, b, c, d;
-    // states
-    MatrixDouble x, x_1;
     // current and previous input/time.
-    MatrixDouble u, u_1;
-    sc_time t, t_1, h;
-    // output
-    MatrixDouble y;
-    // Some helper matrices used in RK solver
-    MatrixDouble k1,k2,k3,k4;
+    T u, u_1;
+    sc_time t, t_1;
+    // The kernel holding the current and the previous states
+    ss_kernel<T>* kernel;
 
     // Output event
     ttn_event<T>* out_ev;
@@ -937,152 +947,48 @@ private:
     {
         out_ev = new ttn_event<T>;
 
-        int /*nn = nums.size(),*/ nd = denominators.size();
-        a = MatrixDouble(nd-1,nd-1);
-        b = MatrixDouble(nd-1,1);
-        c = MatrixDouble(1,nd-1);
-        d = MatrixDouble(1,1);
-
-        tf2ss(numerators,denominators,a,b,c,d);
-
-        // State number
-        int numState = a.size1();
-        assert(a.size1() == a.size2());
-        x = zero_matrix<T>(numState,1), x_1 = zero_matrix<T>(numState,1);
-        u = MatrixDouble(1,1), u_1 = MatrixDouble(1,1);
-        y = MatrixDouble(1,1);
-        k1 = MatrixDouble(numState,1);
-        k2 = MatrixDouble(numState,1);
-        k3 = MatrixDouble(numState,1);
-        k4 = MatrixDouble(numState,1);
+        kernel = make_ss_kernel<T>(numerators, denominators, solver);
 
         // read initial input
         auto in_ev = iport1.read();
-        u(0,0) = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-absent inputs
+        u = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-absent inputs
         t = get_time(in_ev);
         // calculate and write initial output
-        y = boost::numeric::ublas::prod(c,x) + boost::numeric::ublas::prod(d,u);
-        *out_ev = ttn_event<T>(y(0,0), t);
+        *out_ev = ttn_event<T>(kernel->output(0, u), t);
         write_multiport(oport1, *out_ev);
         wait(t - sc_time_stamp());
-        u_1(0,0) = u(0,0);
+        u_1 = u;
         t_1 = t;
     }
 
     void prep()
     {
         auto in_ev = iport1.read();
-        u(0,0) = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-absent inputs
+        u = unsafe_from_abst_ext(get_value(in_ev)); // FIXME: assumes non-absent inputs
         t = get_time(in_ev);
     }
 
     void exec()
     {
-        // 1st step error estimation
-        h = t - t_1;
-        rkSolver(a, b, c, d, u, u_1, x_1, h.to_seconds(), x, y);
-        *out_ev = ttn_event<T>(y(0,0), t);
+        sc_time h = t - t_1;
+        T y = kernel->step(1, 0, h.to_seconds(),
+                           [this](double th) {return linear_input(u_1, u, th);}, NULL);
+        *out_ev = ttn_event<T>(y, t);
     }
 
     void prod()
     {
         write_multiport(oport1, *out_ev);
         wait(t - sc_time_stamp());
-        x_1 = x;
-        u_1(0,0) = u(0,0);
+        kernel->copy(0, 1);
+        u_1 = u;
         t_1 = t;
     }
 
     void clean()
     {
         delete out_ev;
-    }
-
-    // To obtain state space matrices from transfer function.
-    // We assume there are non-zero leading coefficients in num and denom.
-    int tf2ss(std::vector<T> & num_, std::vector<T> & den_, MatrixDouble & a,
-          MatrixDouble & b, MatrixDouble & c, MatrixDouble & d)
-    {
-        std::vector<T> num, den;
-        // sizes checking
-        int nn = num_.size(), nd = den_.size();
-        if(nn >= nd)
-        {
-            std::cerr << "ERROR: " << "degree(num) = " << nn
-            << " >= degree(denom) = " << nd << std::endl;
-            abort();
-        }
-        T dCoef1 = den_.at(0);
-        if(nd==1)
-        {
-            //~ a = NULL, b = NULL, c = NULL;
-            d = MatrixDouble(1,1);
-            d(0,0) = num_.at(0)/dCoef1;
-        }
-        else
-        {
-            if ((nd - nn) > 0)
-            {
-                // Pad num so that degree(num) == degree(denom)
-                for(int i=0; i<nd; i++)
-                {
-                    if(i<(nd-nn))
-                        num.push_back(0.0);
-                    else
-                        num.push_back(num_.at(i-nd+nn));
-                }
-            }
-
-            // Normalizing w.r.t the leading coefficient of denominator
-            for(unsigned int i=0; i<num.size(); i++)
-                num.at(i) /= dCoef1;
-            for(unsigned int i=0; i<den_.size(); i++)
-                den_.at(i) /= dCoef1;
-            for(unsigned int i=0; i<(den_.size()-1); i++)
-                den.push_back(den_.at(i+1));
-
-            // Form A (nd-1)*(nd-1)
-            a = zero_matrix<T> (a.size1(), a.size2());
-            if(nd > 2)
-            {
-                // The eyes (up-right corner) are set to '1'
-                for(int i=0; i<(nd-2); i++)
-                    for(int j=0; j<(nd-1); j++)
-                        if((j-i)==1) a(i,j) = 1.0;
-                // The lower row(s)
-                for(int j=0; j<(nd-1); j++)
-                    a(nd-2,j) = 0-den.at(nd-2-j);
-            }
-            else
-                a(0,0) = 0-den.at(0);
-            //
-            // Form B (nd-1)*1
-            b = zero_matrix<T> (b.size1(), b.size2());
-            b(nd-2,0) = 1.0;
-            //
-            // Form C 1*(nd-1)
-            for(int j=0; j< nd-1; j++)
-                c(0,nd-2-j) = num.at(j+1) - num.at(0)*den.at(j);
-            //
-            // Form D 1*1
-            d(0,0) = num.at(0);
-        }
-
-        return 0;
-    }
-
-    void rkSolver(MatrixDouble a, MatrixDouble b, MatrixDouble c,
-                  MatrixDouble d, MatrixDouble u_k, MatrixDouble u_k_1,
-                  MatrixDouble x, T h, MatrixDouble &x_, MatrixDouble &y)
-    {
-        // Some helper matrices used in RK solver
-        MatrixDouble k1,k2,k3,k4;
-        k1 = boost::numeric::ublas::prod(a,x) + boost::numeric::ublas::prod(b,u_k_1);
-        k2 = boost::numeric::ublas::prod(a,(x+k1*(h/2.0))) + boost::numeric::ublas::prod(b,(u_k_1 + u_k)) * 0.5;
-        k3 = boost::numeric::ublas::prod(a,(x+k2*(h/2.0))) + boost::numeric::ublas::prod(b,(u_k_1 + u_k)) * 0.5;
-        k4 = boost::numeric::ublas::prod(a,(x+k3*h)) + boost::numeric::ublas::prod(b,u_k);
-        x_ = x + (k1 + 2.0*k2 + 2.0*k3 + k4) * (h/6.0);
-        y = boost::numeric::ublas::prod(c,x_) + boost::numeric::ublas::prod(d,u_k);
+        delete kernel;
     }
 
 #ifdef FORSYDE_INTROSPECTION
@@ -1096,6 +1002,35 @@ private:
 #endif
 };
 
+//! Process constructor for implementing a bank of linear filters with fixed step size
+/*! This class is used to build a process which implements N linear
+ * filters of the same order with fixed step size, each with its own
+ * numerator and denominator constants. The tokens carry the values of
+ * all filters in a ct_vector, and the filters are integrated in lockstep
+ * like in the filter_bank process.
+ */
+template <class T, std::size_t N>
+class filterf_bank : public filterf<ct_vector<T,N>>
+{
+public:
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which inserts the initial element, reads
+     * data from its input port, and writes the results using the output
+     * port.
+     */
+    filterf_bank(sc_module_name _name,           ///< process name
+                 const std::vector<std::vector<T>>& numerators,  ///< Numerator constants of the filters
+                 const std::vector<std::vector<T>>& denominators,///< Denominator constants of the filters
+                 filter_solver solver=RK4        ///< Solver of the filters
+                ) : filterf<ct_vector<T,N>>(_name,
+                                            interleave_coefs<T,N>(numerators, true),
+                                            interleave_coefs<T,N>(denominators, false),
+                                            solver) {}
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "DDE::filterf_bank";}
+};
+
 //! Process constructor for a source process
 /*! This class is used to build a souce process which only has an output.
  * Given an initial state and a function, the process repeatedly applies
@@ -1156,7 +1091,7 @@ private:
         *cur_st = init_st;
         write_multiport(oport1, *cur_st);
         wait(get_time(*cur_st) - sc_time_stamp());
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 1;
     }
 
@@ -1424,7 +1359,7 @@ private:
     void prod()
     {
         auto temp_event = ttn_event<std::tuple<abst_ext<T1>,abst_ext<T2>>>(*oval,tl);
-        write_multiport(oport1,temp_event);
+        write_multiport(oport1,std::move(temp_event));
         wait(tl - sc_time_stamp());
     }
 
@@ -1526,7 +1461,7 @@ private:
     void prod()
     {
         auto temp_event = ttn_event<std::array<abst_ext<T1>,N>>(*oval,tl);
-        write_multiport(oport1,temp_event);
+        write_multiport(oport1,std::move(temp_event));
         wait(tl - sc_time_stamp());
     }
 
@@ -1689,7 +1624,7 @@ private:
     void prod()
     {
         for (size_t i=0; i<N; i++)
-            write_multiport(oport[i],oevs[i]);  // write to the output i
+            write_multiport(oport[i],std::move(oevs[i]));  // write to the output i
         wait(tl - sc_time_stamp());
     }
 
@@ -1739,30 +1674,27 @@ public:
     std::string forsyde_kind() const {return "DDE::fanout";}
 
 private:
-    // Inputs and output variables
-    ttn_event<T>* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const ttn_event<T>> val;
 
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new ttn_event<T>;
-    }
+    void init() {}
 
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
 
     void exec() {}
 
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
     }
 
     void clean()
     {
-        delete val;
+        val.reset();
     }
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
@@ -96,7 +96,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -176,7 +176,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -310,7 +310,7 @@ private:
             write_multiport(oport1, abst_ext<OT>());
 
         // Then write out the result
-        write_vec_multiport(oport1, ovals);
+        oport1.move_n(ovals);
 
         // Update tout with the total number of written tokens
         tout += (k+ovals.size());
@@ -481,7 +481,7 @@ private:
         // Then write out the result
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, *ovals);
         }, oport);
 
@@ -582,7 +582,7 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 0;
     }
     
@@ -668,7 +668,7 @@ private:
         cur_st = new abst_ext<T>;
         *cur_st = init_st;
         write_multiport(oport1, *cur_st);
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 1;
     }
     
@@ -1396,30 +1396,27 @@ public:
     std::string forsyde_kind() const {return "DT::fanout";}
     
 private:
-    // Inputs and output variables
-    abst_ext<T>* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const abst_ext<T>> val;
     
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new abst_ext<T>;
-    }
+    void init() {}
     
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
     }
     
     void clean()
     {
-        delete val;
+        val.reset();
     }
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
@@ -37,15 +37,15 @@ using namespace sc_core;
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf>
-inline SY2CT* make_SY2CT(std::string pName,
+template <class T, class OIf, template <class> class IIf>
+inline basic_SY2CT<T>* make_SY2CT(std::string pName,
     sc_time sample_period,     ///< The sampling period
     A2DMode op_mode,          ///< The operation mode
     OIf& outS,
-    IIf& inpS
+    IIf<T>& inpS
     )
 {
-    auto p = new SY2CT(pName.c_str(), sample_period, op_mode);
+    auto p = new basic_SY2CT<T>(pName.c_str(), sample_period, op_mode);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -61,14 +61,14 @@ inline SY2CT* make_SY2CT(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class OIf, class IIf>
-inline CT2SY* make_CT2SY(std::string pName,
+template <class T, template <class> class OIf, class IIf>
+inline basic_CT2SY<T>* make_CT2SY(std::string pName,
     sc_time sample_period,     ///< The sampling period
-    OIf& outS,
+    OIf<T>& outS,
     IIf& inpS
     )
 {
-    auto p = new CT2SY(pName.c_str(), sample_period);
+    auto p = new basic_CT2SY<T>(pName.c_str(), sample_period);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -84,14 +84,15 @@ inline CT2SY* make_CT2SY(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class T, template <class> class OIf, class IIf>
-inline CT2DDE<T>* make_CT2DDE(std::string pName,
+template <class T, template <class> class OIf, class IIf,
+          class TC=typename IIf::value_type>
+inline CT2DDE<T,TC>* make_CT2DDE(std::string pName,
     OIf<T>& outS,
     IIf& inpS1,
     DDE::in_port<unsigned int> inpS2
     )
 {
-    auto p = new CT2DDE<T>(pName.c_str());
+    auto p = new CT2DDE<T,TC>(pName.c_str());
     
     (*p).iport1(inpS1);
     (*p).iport2(inpS2);
@@ -108,14 +109,15 @@ inline CT2DDE<T>* make_CT2DDE(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class T, template <class> class OIf, class IIf>
-inline CT2DDEf<T>* make_CT2DDEf(std::string pName,
+template <class T, template <class> class OIf, class IIf,
+          class TC=typename IIf::value_type>
+inline CT2DDEf<T,TC>* make_CT2DDEf(std::string pName,
     sc_time sampling_period,
     OIf<T>& outS,
     IIf& inpS
     )
 {
-    auto p = new CT2DDEf<T>(pName.c_str(), sampling_period);
+    auto p = new CT2DDEf<T,TC>(pName.c_str(), sampling_period);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
@@ -131,14 +133,15 @@ inline CT2DDEf<T>* make_CT2DDEf(std::string pName,
  * It also removes bilerplate code by using type-inference feature of
  * C++ and automatic binding to the input and output FIFOs.
  */
-template <class T, class OIf, template <class> class IIf>
-inline DDE2CT<T>* make_DDE2CT(std::string pName,
+template <class T, class OIf, template <class> class IIf,
+          class TC=typename OIf::value_type>
+inline DDE2CT<T,TC>* make_DDE2CT(std::string pName,
     A2DMode op_mode,    ///< The operation mode
     OIf& outS,
     IIf<T>& inpS
     )
 {
-    auto p = new DDE2CT<T>(pName.c_str(), op_mode);
+    auto p = new DDE2CT<T,TC>(pName.c_str(), op_mode);
     
     (*p).iport1(inpS);
     (*p).oport1(outS);
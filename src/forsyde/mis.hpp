@@ -22,37 +22,52 @@
  * facilities used for creating MoC interfaces between different MoCs.
  */
 
+//! The largest number of samples a CT interface emits in one firing
+#ifndef FORSYDE_SAMPLE_BATCH
+#define FORSYDE_SAMPLE_BATCH 4096
+#endif
+
 namespace ForSyDe
 {
 using namespace sc_core;
 
 //! Operation modes for the SY2CT converter
-enum A2DMode {LINEAR, HOLD};
+/*! In the CUBIC mode the samples are joined by cubic Hermite segments
+ * whose tangent at each sample is the slope of the quadratic through it
+ * and the two samples before it, so that the signal is smooth and the
+ * segments do not wait for future samples.
+ */
+enum A2DMode {LINEAR, HOLD, CUBIC};
 
 //! Process constructor for a SY2CT MoC interfaces
 /*! This class is used to build a MoC interface which converts an SY 
  * signal to a CT one. It can be used to implement digital-to-analog
- * converters. There are two operating modes which can be configured using
- * the initial values of the constructor:
+ * converters. There are three operating modes which can be configured
+ * using the initial values of the constructor:
  * - sample and hold
  * - linear interpolation
+ * - cubic interpolation
+ * 
+ * The output sub-signals carry closed-form shapes, so no function object
+ * is created per sample.
  */
-class SY2CT : public process
+template <class T>
+class basic_SY2CT : public process
 {
 public:
-    SY::SY_in<CTTYPE> iport1;      ///< port for the input channel
-	CT::CT_out oport1;              ///< port for the output channel
+    SY::SY_in<T> iport1;           ///< port for the input channel
+    CT::basic_CT_out<T> oport1;     ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
      * applies the user-imlpemented function to it and writes the
      * results using the output port
      */
-    SY2CT(sc_module_name _name,      ///< process name
-          sc_time sample_period,     ///< The sampling period
-          A2DMode op_mode = HOLD    ///< The operation mode
-          ) : process(_name), iport1("iport1"), oport1("oport1"),
-              sample_period(sample_period), op_mode(op_mode)
+    basic_SY2CT(sc_module_name _name,      ///< process name
+                sc_time sample_period,     ///< The sampling period
+                A2DMode op_mode = HOLD    ///< The operation mode
+                ) : process(_name), iport1("iport1"), oport1("oport1"),
+                    sample_period(sample_period), op_mode(op_mode)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -72,44 +87,42 @@ private:
 	A2DMode op_mode;
     
     // Internal variables
-    CTTYPE previousVal, currentVal;
-    sub_signal subsig;
+    T previousVal, currentVal;
+    // the slope and the tangent at the end of the previous segment
+    T previousSlope, previousTangent;
+    basic_sub_signal<T> subsig;
     unsigned long iter;
     
     //Implementing the abstract semantics
     void init()
     {
-        currentVal = previousVal = 0;
+        currentVal = previousVal = T();
+        previousSlope = previousTangent = T();
         iter = 0;
     }
     
     void prep()
     {
-        currentVal = (CTTYPE)from_abst_ext(iport1.read(), previousVal);
+        currentVal = (T)from_abst_ext(iport1.read(), previousVal);
     }
     
     void exec()
     {
-        set_range(subsig, sample_period*iter, sample_period*(iter+1));
+        sc_time st = sample_period*iter;
+        set_range(subsig, st, st + sample_period);
+        double h = sample_period.to_seconds();
+        T slope = (currentVal - previousVal)*(1/h);
         if(op_mode==HOLD)
+            set_shape(subsig, basic_poly_shape<T>::constant(previousVal));
+        else if(op_mode==LINEAR)
+            set_shape(subsig, basic_poly_shape<T>::polynomial(st, previousVal, slope));
+        else
         {
-            CTTYPE pv = previousVal;
-            set_function(subsig,[pv](const sc_time& t)
-                                {
-                                    return pv;
-                                }
-            );
-        }
-        else 
-        {
-            CTTYPE dv = currentVal - previousVal;
-            CTTYPE pv = previousVal;
-            unsigned long itr = iter;
-            sc_time sp = sample_period;
-            set_function(subsig,[pv,itr,sp,dv](const sc_time& t)
-            {
-                return (t-itr*sp)/sp*dv + pv;
-            });
+            T tangent = slope*1.5 - previousSlope*0.5;
+            set_shape(subsig, basic_poly_shape<T>::hermite(st, h, previousVal,
+                                        currentVal, previousTangent, tangent));
+            previousSlope = slope;
+            previousTangent = tangent;
         }
     }
     
@@ -134,26 +147,30 @@ private:
 #endif
 };
 
+//! The SY2CT MoC interface for signals of CTTYPE
+typedef basic_SY2CT<CTTYPE> SY2CT;
+
 //! Process constructor for a CT2SY MoC interface
 /*! This class is used to build a MoC interface which converts an CT 
  * signal to a SY one with fixed sampling rate. It can be used to implement 
  * analog-to-digital converters.
  */
-class CT2SY : public process
+template <class T>
+class basic_CT2SY : public process
 {
 public:
-    CT::CT_in iport1;           ///< port for the input channel
-    SY::SY_out<CTTYPE> oport1; ///< port for the output channel
+    CT::basic_CT_in<T> iport1;  ///< port for the input channel
+    SY::SY_out<T> oport1;       ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
      * applies the user-imlpemented function to it and writes the
      * results using the output port
      */
-    CT2SY(sc_module_name _name,      ///< process name
-          sc_time sample_period      ///< The sampling period
-          ) : process(_name), iport1("iport1"), oport1("oport1"),
-              sample_period(sample_period)
+    basic_CT2SY(sc_module_name _name,      ///< process name
+                sc_time sample_period      ///< The sampling period
+                ) : process(_name), iport1("iport1"), oport1("oport1"),
+                    sample_period(sample_period)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::stringstream ss;
@@ -169,8 +186,9 @@ private:
     sc_time sample_period;
     
     // Internal variables
-    sub_signal in_ss;
-    CTTYPE out_val;
+    basic_sub_signal<T> in_ss;
+    std::vector<T> samples;
+    std::vector<abst_ext<T>> out_vals;
     sc_time local_time, sampling_time;
     
     //Implementing the abstract semantics
@@ -190,12 +208,18 @@ private:
     
     void exec()
     {
-        out_val = in_ss(sampling_time);
+        // All of the samples in the current sub-signal, up to a batch
+        size_t n = std::min<size_t>(count_samples(in_ss, sampling_time, sample_period),
+                                    FORSYDE_SAMPLE_BATCH);
+        samples.resize(n);
+        sample_n(in_ss, sampling_time, sample_period, n, samples.data());
+        out_vals.assign(samples.begin(), samples.end());
+        sampling_time = sc_time::from_value(sampling_time.value() + (n-1)*sample_period.value());
     }
     
     void prod()
     {
-        write_multiport(oport1, out_val);
+        oport1.move_n(out_vals);
         wait(sampling_time - sc_time_stamp());
         sampling_time += sample_period;
     }
@@ -213,16 +237,19 @@ private:
 #endif
 };
 
+//! The CT2SY MoC interface for signals of CTTYPE
+typedef basic_CT2SY<CTTYPE> CT2SY;
+
 //! Process constructor for a CT2DDE MoC interface
 /*! This class is used to build a MoC interface which converts an CT 
  * signal to a DDE one with adaptive sampling rate. It can be used to
  * implement analog-to-digital converters with adaptive sampling rates.
  */
-template<class T>
+template<class T, class TC=CTTYPE>
 class CT2DDE : public process
 {
 public:
-    CT::CT_in iport1;               ///< port for the input channel
+    CT::basic_CT_in<TC> iport1;     ///< port for the input channel
     DDE::DDE_in<unsigned int> iport2; ///< port for the sampling channel
     DDE::DDE_out<T> oport1;           ///< port for the output channel
 
@@ -240,34 +267,47 @@ public:
 
 private:    
     // Internal variables
-    sub_signal f;
-    std::vector<sub_signal > vecCTsignal; // a queue to be committed
-    //~ sub_signal in_val;
-    abst_ext<T> out_val;
-    sc_time samplingT;
-    unsigned int samplingType, iter;
+    basic_sub_signal<TC> f;
+    std::vector<basic_sub_signal<TC>> vecCTsignal; // a queue to be committed
+    // the sampling requests of a firing and the samples they produce
+    std::vector<ttn_event<unsigned int>> requests;
+    std::vector<ttn_event<T>> out_evs;
+    sc_time last_time;
+    unsigned int iter;
     
     //Implementing the abstract semantics
     void init()
     {
         iter = 0;
-        //~ in_val = iport1.read();
-        //~ cur_time = get_start_time(in_val);
+        last_time = SC_ZERO_TIME;
     }
     
     void prep()
     {
-        //~ while (cur_time >= get_end_time(in_val)) in_val = iport1.read();
-        auto e = iport2.read();
-        samplingType = unsafe_from_abst_ext(get_value(e)); // FIXME: what if absent?
-        samplingT = get_time(e);
+        // The requests which are already available are served together
+        requests.assign(1, iport2.read());
+        while (iport2.num_available() > 0 && requests.size() < FORSYDE_SAMPLE_BATCH)
+            requests.push_back(iport2.read());
     }
     
     void exec() {}
     
     void prod()
     {
-        //FIXME: this code should be split between prep, prod, and probably exec
+        for (auto& e : requests)
+        {
+            unsigned int samplingType = unsafe_from_abst_ext(get_value(e)); // FIXME: what if absent?
+            sample(samplingType, get_time(e));
+        }
+        oport1.move_n(out_evs);
+        out_evs.clear();
+        if (last_time > sc_time_stamp())
+            wait(last_time - sc_time_stamp());
+    }
+    
+    // Serves a sampling request or a commitment
+    void sample(unsigned int samplingType, const sc_time& samplingT)
+    {
         if(samplingType!=1)
         { 
             // just sampling (without commitment) in 
@@ -278,50 +318,25 @@ private:
                 if(samplingType==0)
                     vecCTsignal.push_back(f);
             }
-            if((samplingT >= get_start_time(f)) && (samplingT < get_end_time(f)))
-            {
-                write_multiport(oport1,ttn_event<T>(f(samplingT), samplingT));
-                wait(samplingT - sc_time_stamp());
-            }
-            else if(samplingT >= get_end_time(f))
+            while(samplingT >= get_end_time(f))
             {
                 f = iport1.read();
                 if(samplingType==0)
                     vecCTsignal.push_back(f);
-                if ((samplingT >= get_start_time(f)) && (samplingT < get_end_time(f)))
-                {
-                    write_multiport(oport1,ttn_event<T>(f(samplingT), samplingT));
-                    wait(samplingT - sc_time_stamp());
-                }
-                else
-                {
-                    while(samplingT >= get_end_time(f))
-                    {
-                        f = iport1.read();
-                        if(samplingType==0)
-                            vecCTsignal.push_back(f);
-                    }
-                    write_multiport(oport1,ttn_event<T>(f(samplingT), samplingT));
-                    wait(samplingT - sc_time_stamp());
-                }
             }
+            if(samplingT >= get_start_time(f))
+                out_evs.push_back(ttn_event<T>(f(samplingT), samplingT));
             else
             {
                 // To check the sampling from the queue
-                while(!vecCTsignal.empty())
-                {
-                    if(samplingT >= get_end_time(vecCTsignal.front()))
-                        vecCTsignal.erase(vecCTsignal.begin());
-                    else
-                    {
-                        write_multiport(oport1,ttn_event<T>(vecCTsignal.front()(samplingT), samplingT));
-                        wait(samplingT - sc_time_stamp());
-                        break;
-                    }
-                }
+                while(!vecCTsignal.empty() &&
+                      samplingT >= get_end_time(vecCTsignal.front()))
+                    vecCTsignal.erase(vecCTsignal.begin());
                 if(vecCTsignal.empty())
                     assert(0);  // if have not get the sampling
+                out_evs.push_back(ttn_event<T>(vecCTsignal.front()(samplingT), samplingT));
             }
+            last_time = std::max(last_time, samplingT);
         }
         else
         {
@@ -358,11 +373,11 @@ private:
  * signal to a DDE one with fixed sampling rate. It can be used to
  * implement analog-to-digital converters with fixed sampling rates.
  */
-template<class T>
+template<class T, class TC=CTTYPE>
 class CT2DDEf : public process
 {
 public:
-    CT::CT_in iport1;               ///< port for the input channel
+    CT::basic_CT_in<TC> iport1;     ///< port for the input channel
     DDE::DDE_out<T> oport1;           ///< port for the output channel
 
     //! The constructor requires the module name
@@ -381,9 +396,10 @@ public:
 private:    
     // Internal variables
     sc_time samp_period;
-    abst_ext<T> out_val;
+    std::vector<TC> samples;
+    std::vector<ttn_event<T>> out_evs;
     sc_time local_time, sampling_time;
-    sub_signal in_ss;
+    basic_sub_signal<TC> in_ss;
     
     //Implementing the abstract semantics
     void init()
@@ -402,12 +418,21 @@ private:
     
     void exec()
     {
-        out_val = abst_ext<T>(in_ss(sampling_time));
+        // All of the samples in the current sub-signal, up to a batch
+        size_t n = std::min<size_t>(count_samples(in_ss, sampling_time, samp_period),
+                                    FORSYDE_SAMPLE_BATCH);
+        samples.resize(n);
+        sample_n(in_ss, sampling_time, samp_period, n, samples.data());
+        out_evs.resize(n);
+        for (size_t i=0; i<n; i++)
+            out_evs[i] = ttn_event<T>(abst_ext<T>(samples[i]),
+                sc_time::from_value(sampling_time.value() + i*samp_period.value()));
+        sampling_time = get_time(out_evs.back());
     }
     
     void prod()
     {
-        write_multiport(oport1,ttn_event<T>(out_val, sampling_time));
+        oport1.move_n(out_evs);
         wait(sampling_time - sc_time_stamp());
         sampling_time += samp_period;
     }
@@ -428,17 +453,21 @@ private:
 //! Process constructor for a DDE2CT MoC interfaces
 /*! This class is used to build a MoC interfaces which converts a DDE 
  * signal to a CT one. It can be used to implement digital-to-analog
- * converters. There are two operating modes which can be configured using
- * the initial values of the constructor:
+ * converters. There are three operating modes which can be configured
+ * using the initial values of the constructor:
  * - sample and hold
  * - linear interpolation
+ * - cubic interpolation
+ * 
+ * The output sub-signals carry closed-form shapes, so no function object
+ * is created per event.
  */
-template<class T>
+template<class T, class TC=CTTYPE>
 class DDE2CT : public process
 {
 public:
     DDE::DDE_in<T> iport1;        ///< port for the input channel
-	CT::CT_out oport1;          ///< port for the output channel
+    CT::basic_CT_out<TC> oport1;  ///< port for the output channel
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -464,15 +493,20 @@ private:
 	A2DMode op_mode;
     
     // Internal variables
-    CTTYPE previousVal, currentVal;
+    TC previousVal, currentVal;
     sc_time previousT, currentT;
-    sub_signal subsig;
+    // the slope, the tangent at the end and the length of the previous segment
+    TC previousSlope, previousTangent;
+    double previousStep;
+    basic_sub_signal<TC> subsig;
     
     //Implementing the abstract semantics
     void init()
     {
-        previousVal = currentVal = 0;
+        previousVal = currentVal = TC();
         previousT = currentT = SC_ZERO_TIME;
+        previousSlope = previousTangent = TC();
+        previousStep = 0;
     }
     
     void prep()
@@ -480,7 +514,7 @@ private:
         while (currentT <= previousT)
         {
             auto in_ev = iport1.read();
-            currentVal = (double)from_abst_ext(get_value(in_ev), previousVal);
+            currentVal = (TC)from_abst_ext(get_value(in_ev), previousVal);
             currentT = get_time(in_ev);
         }
     }
@@ -488,22 +522,22 @@ private:
     void exec()
     {
         set_range(subsig, previousT, currentT);
+        double h = (currentT - previousT).to_seconds();
+        TC slope = (currentVal - previousVal)*(1/h);
         if(op_mode==HOLD)
+            set_shape(subsig, basic_poly_shape<TC>::constant(previousVal));
+        else if(op_mode==LINEAR)
+            set_shape(subsig, basic_poly_shape<TC>::polynomial(previousT, previousVal, slope));
+        else
         {
-            CTTYPE pv = previousVal;
-            set_function(subsig,[=](sc_time t){
-						return pv;
-						});
-        }
-        else 
-        {
-            CTTYPE dv = currentVal - previousVal;
-            sc_time dt = currentT - previousT;
-            sc_time pt = previousT;
-            CTTYPE pv = previousVal;
-            set_function(subsig,[=](sc_time t)->CTTYPE{
-                    return ((t-pt)/dt*dv + pv);
-            });
+            // The segments before the first one are as long as it
+            double w = h/((previousStep > 0 ? previousStep : h) + h);
+            TC tangent = slope + (slope - previousSlope)*w;
+            set_shape(subsig, basic_poly_shape<TC>::hermite(previousT, h, previousVal,
+                                        currentVal, previousTangent, tangent));
+            previousSlope = slope;
+            previousTangent = tangent;
+            previousStep = h;
         }
     }
     
@@ -580,7 +614,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -0,0 +1,244 @@
+/**********************************************************************
+    * mpi_message.hpp -- Transmission of tokens in MPI messages       *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Sending and receiving vectors of tokens as single MPI  *
+    *          messages from SystemC threads                          *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef MPI_MESSAGE_HPP
+#define MPI_MESSAGE_HPP
+
+/*! \file mpi_message.hpp
+ * \brief Implements the MPI messages used in parallel simulations
+ *
+ *  This file includes the functions which transmit a vector of tokens as
+ * a single MPI message. Tokens of trivially copyable types are not
+ * serialized at all. They are transmitted directly from the token
+ * buffers using a contiguous MPI derived datatype. Vectors and strings
+ * of trivially copyable elements (e.g., frames) are not serialized
+ * either: send_message and recv_message transmit their sizes followed by
+ * their elements, which are described by an hindexed MPI datatype over
+ * the storage of the tokens. The other tokens are serialized using the
+ * serializer trait.
+ */
+
+#include <mpi.h>
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+
+#include "serialization.hpp"
+
+namespace ForSyDe
+{
+
+//! The MPI datatype used to transmit tokens of a contiguous type T
+/*! The datatype is created and committed once on the first use.
+ */
+template <typename T>
+inline MPI_Datatype mpi_datatype()
+{
+    static MPI_Datatype type = []()
+    {
+        MPI_Datatype t;
+        MPI_Type_contiguous(sizeof(T), MPI_BYTE, &t);
+        MPI_Type_commit(&t);
+        return t;
+    }();
+    return type;
+}
+
+//! Can tokens of type T be transmitted from their contiguous storage?
+template <typename T>
+struct is_contiguous_token : std::false_type {};
+
+template <typename E, typename A>
+struct is_contiguous_token<std::vector<E,A>> : is_bitwise_token<E> {};
+
+template <typename C, typename Tr, typename A>
+struct is_contiguous_token<std::basic_string<C,Tr,A>> : std::true_type {};
+
+//! The MPI datatype describing the storage of the contiguous tokens in vals
+/*! The datatype uses absolute addresses, so it is used with MPI_BOTTOM,
+ * and it should be freed after the transfer. Tokens larger than INT_MAX
+ * bytes are described by several blocks.
+ */
+template <typename T>
+inline MPI_Datatype mpi_storage_type(const std::vector<T>& vals)
+{
+    typedef typename T::value_type E;
+    std::vector<int> lengths;
+    std::vector<MPI_Aint> addrs;
+    for (size_t i=0; i<vals.size(); i++)
+    {
+        size_t bytes = vals[i].size()*sizeof(E);
+        if (bytes == 0) continue;
+        MPI_Aint addr;
+        MPI_Get_address(const_cast<E*>(vals[i].data()), &addr);
+        while (bytes > 0)
+        {
+            int len = (int)std::min<size_t>(bytes, INT_MAX);
+            lengths.push_back(len);
+            addrs.push_back(addr);
+            addr = MPI_Aint_add(addr, len);
+            bytes -= len;
+        }
+    }
+    MPI_Datatype t;
+    MPI_Type_create_hindexed(lengths.size(), lengths.data(), addrs.data(), MPI_BYTE, &t);
+    MPI_Type_commit(&t);
+    return t;
+}
+
+//! Waits in zero-time steps until a message from source arrives
+inline void wait_message(int source, int tag, MPI_Status& status)
+{
+    int flag=0;
+    while (true)
+    {
+        MPI_Iprobe(source, tag, MPI_COMM_WORLD, &flag, &status);
+        if (flag) break; else sc_core::wait(0,sc_core::SC_NS);
+    }
+}
+
+//! Waits in zero-time steps until a non-blocking transfer completes
+inline void wait_request(MPI_Request& request)
+{
+    MPI_Status status;
+    int flag=0;
+    while (true)
+    {
+        MPI_Test(&request, &flag, &status);
+        if (flag) break; else sc_core::wait(0,sc_core::SC_NS);
+    }
+}
+
+//! Prepares a message with the tokens in vals
+/*! On return, data, count and type describe the message. Tokens of
+ * contiguous types are sent directly from vals, while the others
+ * (including the vectors sent in two parts by send_message) are
+ * serialized into buf.
+ */
+template <typename T>
+inline void pack_message(const std::vector<T>& vals, std::vector<char>& buf,
+                         const void*& data, int& count, MPI_Datatype& type)
+{
+    if constexpr (is_bitwise_token<T>::value)
+    {
+        data = vals.data();
+        count = vals.size();
+        type = mpi_datatype<T>();
+    }
+    else
+    {
+        buf.clear();
+        pack_tokens(vals, buf);
+        data = buf.data();
+        count = buf.size();
+        type = MPI_BYTE;
+    }
+}
+
+//! Extracts the tokens of a received message into vals
+/*! The message is received using the status returned by probing it.
+ */
+template <typename T>
+inline void unpack_message(int source, int tag, MPI_Status& status,
+                           std::vector<char>& buf, std::vector<T>& vals)
+{
+    if constexpr (is_bitwise_token<T>::value)
+    {
+        int count;
+        MPI_Get_count(&status, mpi_datatype<T>(), &count);
+        vals.resize(count);
+        MPI_Recv(vals.data(), count, mpi_datatype<T>(), source, tag,
+                 MPI_COMM_WORLD, &status);
+    }
+    else
+    {
+        int bytes;
+        MPI_Get_count(&status, MPI_BYTE, &bytes);
+        buf.resize(bytes);
+        MPI_Recv(buf.data(), bytes, MPI_BYTE, source, tag, MPI_COMM_WORLD, &status);
+        unpack_tokens(buf.data(), buf.size(), vals);
+    }
+}
+
+//! Receives the next message carrying any number of tokens of type T
+/*! The message is probed first to learn its size. The calling process
+ * waits in zero-time steps until the message arrives, so that the rest
+ * of the sub-simulation can proceed.
+ */
+template <typename T>
+inline void recv_message(int source, int tag, std::vector<char>& buf,
+                         std::vector<T>& vals)
+{
+    MPI_Status status;
+    wait_message(source, tag, status);
+    if constexpr (is_contiguous_token<T>::value)
+    {
+        // The sizes of the tokens are received first
+        int count;
+        MPI_Get_count(&status, MPI_UNSIGNED_LONG_LONG, &count);
+        std::vector<unsigned long long> sizes(count);
+        MPI_Recv(sizes.data(), count, MPI_UNSIGNED_LONG_LONG, source, tag,
+                 MPI_COMM_WORLD, &status);
+        vals.resize(count);
+        for (int i=0; i<count; i++)
+            vals[i].resize(sizes[i]);
+        // The elements are received in place
+        MPI_Datatype type = mpi_storage_type(vals);
+        wait_message(source, tag, status);
+        MPI_Recv(MPI_BOTTOM, 1, type, source, tag, MPI_COMM_WORLD, &status);
+        MPI_Type_free(&type);
+    }
+    else
+        unpack_message(source, tag, status, buf, vals);
+}
+
+//! Sends a message carrying the tokens in vals
+/*! The calling process waits in zero-time steps until the message is
+ * sent.
+ */
+template <typename T>
+inline void send_message(int destination, int tag, std::vector<char>& buf,
+                         const std::vector<T>& vals)
+{
+    MPI_Request request;
+    if constexpr (is_contiguous_token<T>::value)
+    {
+        // The sizes of the tokens followed by their elements, which are
+        // sent from their storage
+        std::vector<unsigned long long> sizes(vals.size());
+        for (size_t i=0; i<vals.size(); i++)
+            sizes[i] = vals[i].size();
+        MPI_Request data_request;
+        MPI_Isend(sizes.data(), sizes.size(), MPI_UNSIGNED_LONG_LONG,
+                  destination, tag, MPI_COMM_WORLD, &request);
+        MPI_Datatype type = mpi_storage_type(vals);
+        MPI_Isend(MPI_BOTTOM, 1, type, destination, tag, MPI_COMM_WORLD, &data_request);
+        MPI_Type_free(&type);
+        wait_request(request);
+        wait_request(data_request);
+    }
+    else
+    {
+        const void* data;
+        int count;
+        MPI_Datatype type;
+        pack_message(vals, buf, data, count, type);
+        MPI_Isend(data, count, type, destination, tag, MPI_COMM_WORLD, &request);
+        wait_request(request);
+    }
+}
+
+}
+
+#endif
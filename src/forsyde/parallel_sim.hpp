@@ -19,9 +19,40 @@
  * 
  *  This file includes the basic process constructors and other
  * facilities used for enabling parallel simulations.
+ *
+ * A sender can aggregate several tokens into one MPI message to reduce
+ * the number of messages and of the delta cycles spent waiting for
+ * them. It sends a message when it has packed batch tokens, or earlier
+ * when its input signal stays empty for more than lookahead delta
+ * cycles, so that a partial batch is never held back indefinitely
+ * (e.g., in a feedback loop across the ranks). The receivers unpack all
+ * tokens of each message into their output signal, so they work with
+ * any batch size.
+ *
+ * The tokens are transmitted using the serializer trait, so tokens with
+ * heap storage such as vectors and strings can be sent between ranks.
+ *
+ * The DDE senders and receivers also synchronize the simulated times of
+ * the ranks conservatively, in the style of the Chandy-Misra-Bryant
+ * algorithm. Each message carries a lower bound for the time tags of
+ * the events which the sender may still transmit, and a DDE receiver
+ * never lets its sub-simulation advance beyond this bound. When the
+ * receivers of a rank cannot proceed, the rank sends null messages with
+ * the bounds it can guarantee, using the time of its next pending
+ * activity and the lookahead declared for each sender.
  */
 
 #include <mpi.h>
+#include <vector>
+#include <deque>
+#include <tuple>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+#include "mpi_message.hpp"
 
 namespace ForSyDe
 {
@@ -34,7 +65,8 @@ using namespace sc_core;
 
 //! Process constructor for a sender process with one input
 /*! This class is used to build a processes with one input. It transmits
- * the non-absent events it receives using an MPI_send command.
+ * the non-absent events it receives using an MPI_send command. Up to
+ * batch tokens are packed into each message.
  */
 template <typename T1>
 class sender : public sy_process
@@ -49,13 +81,20 @@ public:
      */
     sender(sc_module_name _name,     ///< process name
            int destination,          ///< MPI rank of the destination process
-           int tag                   ///< MPI tag of the message
+           int tag,                  ///< MPI tag of the message
+           unsigned batch=1,         ///< maximum number of tokens per message
+           unsigned lookahead=0      ///< delta cycles to wait for more tokens
          ) : sy_process(_name), iport1("iport1"),
-             destination(destination), tag(tag)
+             destination(destination), tag(tag),
+             batch(batch), lookahead(lookahead)
     {
+        if (batch == 0)
+            SC_REPORT_ERROR(name(), "the batch size should be at least one");
 #ifdef FORSYDE_INTROSPECTION
         arg_vec.push_back(std::make_tuple("destination",std::to_string(destination)));
         arg_vec.push_back(std::make_tuple("tag",std::to_string(tag)));
+        arg_vec.push_back(std::make_tuple("batch",std::to_string(batch)));
+        arg_vec.push_back(std::make_tuple("lookahead",std::to_string(lookahead)));
 #endif
     }
     
@@ -65,40 +104,43 @@ public:
 private:
     int destination;
     int tag;
+    unsigned batch;
+    unsigned lookahead;
     
     // Inputs and output variables
-    T1* ival1;
+    std::vector<T1>* ivals;
+    std::vector<char> buf;      ///< serialized tokens of a message
     
     //Implementing the abstract semantics
     void init()
     {
-        ival1 = new T1;
+        ivals = new std::vector<T1>;
+        ivals->reserve(batch);
     }
     
     void prep()
     {
         abst_ext<T1> temp_val = iport1.read();
-        *ival1 = unsafe_from_abst_ext(temp_val);
+        ivals->push_back(unsafe_from_abst_ext(temp_val));
     }
     
     void exec() {}
     
     void prod()
     {
-        MPI_Request request;
-        MPI_Status status;
-        MPI_Isend(ival1, sizeof(T1), MPI_BYTE, destination, tag, MPI_COMM_WORLD, &request);
-        int flag=0;
-        while (true)
+        if (ivals->size() < batch)
         {
-            MPI_Test(&request, &flag, &status);
-            if (flag) break; else wait(0,SC_NS);
+            for (unsigned i=0; i<lookahead && iport1.num_available()==0; i++)
+                wait(SC_ZERO_TIME);
+            if (iport1.num_available() > 0) return;
         }
+        send_message(destination, tag, buf, *ivals);
+        ivals->clear();
     }
     
     void clean()
     {
-        delete ival1;
+        delete ivals;
     }
     
 #ifdef FORSYDE_INTROSPECTION
@@ -113,7 +155,7 @@ private:
 //! Process constructor for a receiver process with one output
 /*! This class is used to build a processes with one output.
  * It receives non-absent events via MPI_recv command and writes them to
- * its output signal.
+ * its output signal. Each message may carry several events.
  */
 template <typename T0>
 class receiver : public sy_process
@@ -146,39 +188,38 @@ private:
     int tag;
     
     // Inputs and output variables
-    abst_ext<T0>* oval1;
+    std::vector<char> buf;      ///< serialized tokens of a message
+    std::vector<T0>* msg;
+    std::vector<abst_ext<T0>>* ovals;
     
     //Implementing the abstract semantics
     void init()
     {
-        oval1 = new abst_ext<T0>;
+        msg = new std::vector<T0>;
+        ovals = new std::vector<abst_ext<T0>>;
     }
     
     void prep()
     {
-        T0 temp_val;
-        MPI_Status status;
-        MPI_Request request;
-        MPI_Irecv(&temp_val, sizeof(T0), MPI_BYTE, source, tag, MPI_COMM_WORLD, &request);
-        int flag=0;
-        while (true)
-        {
-            MPI_Test(&request, &flag, &status);
-            if (flag) break; else wait(0,SC_NS);
-        }
-        set_val(*oval1, temp_val);
+        recv_message(source, tag, buf, *msg);
     }
     
-    void exec() {}
+    void exec()
+    {
+        ovals->resize(msg->size());
+        for (size_t i=0; i<msg->size(); i++)
+            set_val((*ovals)[i], (*msg)[i]);
+    }
     
     void prod()
     {
-        write_multiport(oport1, *oval1)
+        oport1.write_n(*ovals);
     }
     
     void clean()
     {
-        delete oval1;
+        delete msg;
+        delete ovals;
     }
     
 #ifdef FORSYDE_INTROSPECTION
@@ -201,7 +242,8 @@ using namespace sc_core;
 
 //! Process constructor for a sender process with one input
 /*! This class is used to build a processes with one input. It transmits
- * the non-absent events it receives using an MPI_send command.
+ * the non-absent events it receives using an MPI_send command. Up to
+ * batch tokens are packed into each message.
  */
 template <typename T1>
 class sender : public sdf_process
@@ -216,13 +258,20 @@ public:
      */
     sender(sc_module_name _name,     ///< process name
            int destination,          ///< MPI rank of the destination process
-           int tag                   ///< MPI tag of the message
+           int tag,                  ///< MPI tag of the message
+           unsigned batch=1,         ///< maximum number of tokens per message
+           unsigned lookahead=0      ///< delta cycles to wait for more tokens
          ) : sdf_process(_name), iport1("iport1"),
-             destination(destination), tag(tag)
+             destination(destination), tag(tag),
+             batch(batch), lookahead(lookahead)
     {
+        if (batch == 0)
+            SC_REPORT_ERROR(name(), "the batch size should be at least one");
 #ifdef FORSYDE_INTROSPECTION
         arg_vec.push_back(std::make_tuple("destination",std::to_string(destination)));
         arg_vec.push_back(std::make_tuple("tag",std::to_string(tag)));
+        arg_vec.push_back(std::make_tuple("batch",std::to_string(batch)));
+        arg_vec.push_back(std::make_tuple("lookahead",std::to_string(lookahead)));
 #endif
     }
     
@@ -232,40 +281,42 @@ public:
 private:
     int destination;
     int tag;
+    unsigned batch;
+    unsigned lookahead;
     
     // Inputs and output variables
-    T1* ival1;
+    std::vector<T1>* ivals;
+    std::vector<char> buf;      ///< serialized tokens of a message
     
     //Implementing the abstract semantics
     void init()
     {
-        ival1 = new T1;
+        ivals = new std::vector<T1>;
+        ivals->reserve(batch);
     }
     
     void prep()
     {
-        T1 temp_val = iport1.read();
-        *ival1 = temp_val;
+        ivals->push_back(iport1.read());
     }
     
     void exec() {}
     
     void prod()
     {
-        MPI_Request request;
-        MPI_Status status;
-        MPI_Isend(ival1, sizeof(T1), MPI_BYTE, destination, tag, MPI_COMM_WORLD, &request);
-        int flag=0;
-        while (true)
+        if (ivals->size() < batch)
         {
-            MPI_Test(&request, &flag, &status);
-            if (flag) break; else wait(0,SC_NS);
+            for (unsigned i=0; i<lookahead && iport1.num_available()==0; i++)
+                wait(SC_ZERO_TIME);
+            if (iport1.num_available() > 0) return;
         }
+        send_message(destination, tag, buf, *ivals);
+        ivals->clear();
     }
     
     void clean()
     {
-        delete ival1;
+        delete ivals;
     }
     
 #ifdef FORSYDE_INTROSPECTION
@@ -280,7 +331,7 @@ private:
 //! Process constructor for a receiver process with one output
 /*! This class is used to build a processes with one output.
  * It receives non-absent events via MPI_recv command and writes them to
- * its output signal.
+ * its output signal. Each message may carry several events.
  */
 template <typename T0>
 class receiver : public sdf_process
@@ -313,39 +364,373 @@ private:
     int tag;
     
     // Inputs and output variables
-    T0* oval1;
+    std::vector<char> buf;      ///< serialized tokens of a message
+    std::vector<T0>* ovals;
     
     //Implementing the abstract semantics
     void init()
     {
-        oval1 = new T0;
+        ovals = new std::vector<T0>;
     }
     
     void prep()
     {
-        T0 temp_val;
-        MPI_Status status;
+        recv_message(source, tag, buf, *ovals);
+    }
+    
+    void exec() {}
+    
+    void prod()
+    {
+        oport1.write_n(*ovals);
+    }
+    
+    void clean()
+    {
+        delete ovals;
+    }
+    
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundOutChans.resize(1);    // only one output port
+        boundOutChans[0].port = &oport1;
+    }
+#endif
+};
+
+
+}
+
+namespace DDE
+{
+
+using namespace sc_core;
+
+
+//! The synchronization state shared by the DDE links of a sub-simulation
+/*! The DDE receivers which need a message from another rank to advance
+ * their time register themselves here. The first of them waits until
+ * the rest of the sub-simulation settles at the current time, sends the
+ * lower bounds of all DDE senders as null messages and then waits for a
+ * message on any of the registered links. The other receivers wait for
+ * it to notify them.
+ */
+class link_sync
+{
+public:
+    //! The single instance of a sub-simulation
+    static link_sync& get()
+    {
+        // never destroyed, since the event outlives the simulation context
+        static link_sync* sync = new link_sync;
+        return *sync;
+    }
+
+    //! Functions sending the bounds of the senders
+    /*! They are called with the time of the next pending activity and the
+     * earliest bound of the receivers.
+     */
+    std::vector<std::function<void(const sc_time&, const sc_time&)>> senders;
+
+    //! The time bounds of the receivers
+    std::vector<const sc_time*> bounds;
+
+    //! Waits until a message on the given link might have arrived
+    void starve(int source, int tag)
+    {
+        auto link = std::make_pair(source, tag);
+        starving.push_back(link);
+        if (polling)
+            wait(arrived);
+        else
+        {
+            polling = true;
+            while (sc_pending_activity_at_current_time())
+                wait(SC_ZERO_TIME);
+            publish();
+            // The sub-simulation cannot proceed without the other ranks,
+            // so the probes back off up to a millisecond apart
+            int flag = 0;
+            std::chrono::microseconds pause(1);
+            while (true)
+            {
+                for (auto it=starving.begin();it!=starving.end() && !flag;it++)
+                    MPI_Iprobe(it->first, it->second, MPI_COMM_WORLD, &flag,
+                               MPI_STATUS_IGNORE);
+                if (flag) break;
+                std::this_thread::sleep_for(pause);
+                pause = std::min(pause*2, std::chrono::microseconds(1000));
+            }
+            polling = false;
+            arrived.notify(SC_ZERO_TIME);
+        }
+        starving.erase(std::find(starving.begin(), starving.end(), link));
+    }
+
+private:
+    std::vector<std::pair<int,int>> starving;
+    sc_event arrived;
+    bool polling = false;
+
+    //! Sends the null messages of all senders
+    void publish()
+    {
+        sc_time next = sc_time_stamp() + sc_time_to_pending_activity();
+        sc_time recv = sc_max_time();
+        for (auto it=bounds.begin();it!=bounds.end();it++)
+            recv = std::min(recv, **it);
+        for (auto it=senders.begin();it!=senders.end();it++)
+            (*it)(next, recv);
+    }
+};
+
+//! Process constructor for a sender process with one input
+/*! This class is used to build a processes with one input. It transmits
+ * the events it receives, including the absent ones, using MPI. Up to
+ * batch events are packed into each message.
+ *
+ * Each message also carries a lower bound for the tags of the following
+ * events. Between messages, the bound is raised by null messages which
+ * carry no events. The lookahead is the minimum difference between the
+ * tag of an event that a receiver of the same sub-simulation writes and
+ * the tags of the events that it causes in the input of the sender (e.g.,
+ * the delay time of a DDE::delay on the path). At least one sender in
+ * each cycle through the ranks should declare a positive lookahead, or
+ * the ranks might not advance their times.
+ */
+template <typename T1>
+class sender : public dde_process
+{
+public:
+    DDE_in<T1>  iport1;       ///< port for the input channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from its input port,
+     * applies the user-imlpemented function to it and writes the
+     * results using the output port
+     */
+    sender(sc_module_name _name,     ///< process name
+           int destination,          ///< MPI rank of the destination process
+           int tag,                  ///< MPI tag of the message
+           sc_time lookahead=SC_ZERO_TIME,  ///< lookahead from the receivers
+           unsigned batch=1          ///< maximum number of events per message
+         ) : dde_process(_name), iport1("iport1"),
+             destination(destination), tag(tag),
+             lookahead(lookahead), batch(batch)
+    {
+        if (batch == 0)
+            SC_REPORT_ERROR(name(), "the batch size should be at least one");
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("destination",std::to_string(destination)));
+        arg_vec.push_back(std::make_tuple("tag",std::to_string(tag)));
+        arg_vec.push_back(std::make_tuple("lookahead",lookahead.to_string()));
+        arg_vec.push_back(std::make_tuple("batch",std::to_string(batch)));
+#endif
+    }
+    
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "DDE::sender";}
+
+private:
+    int destination;
+    int tag;
+    sc_time lookahead;
+    unsigned batch;
+    
+    //! A message carries the bound and the events
+    typedef std::tuple<sc_dt::uint64,std::vector<ttn_event<T1>>> message;
+    
+    //! A null message which is still being sent
+    struct null_message
+    {
+        std::vector<message> msg;
+        std::vector<char> buf;
         MPI_Request request;
-        MPI_Irecv(&temp_val, sizeof(T0), MPI_BYTE, source, tag, MPI_COMM_WORLD, &request);
-        int flag=0;
+    };
+    
+    // Inputs and output variables
+    std::vector<message>* msg;
+    std::vector<char> buf;      ///< serialized events of a message
+    std::deque<null_message> nulls;  ///< null messages in flight
+    sc_time sent;               ///< the last bound sent
+    
+    //Implementing the abstract semantics
+    void init()
+    {
+        msg = new std::vector<message>(1);
+        std::get<1>((*msg)[0]).reserve(batch);
+        sent = SC_ZERO_TIME;
+        link_sync::get().senders.push_back(
+            [this](const sc_time& next, const sc_time& recv)
+            {
+                sc_time bound = recv > sc_max_time() - lookahead ?
+                                sc_max_time() : recv + lookahead;
+                send_bound(std::min(next, bound));
+            });
+    }
+    
+    void prep()
+    {
+        auto& evs = std::get<1>((*msg)[0]);
+        evs.clear();
+        evs.push_back(iport1.read());
+        while (evs.size() < batch && iport1.num_available() > 0)
+            evs.push_back(iport1.read());
+    }
+    
+    void exec()
+    {
+        // The following events are not earlier than the last one or the
+        // current time
+        sent = std::max({sent, sc_time_stamp(), get_time(std::get<1>((*msg)[0]).back())});
+        std::get<0>((*msg)[0]) = sent.value();
+    }
+    
+    void prod()
+    {
+        send_message(destination, tag, buf, *msg);
+    }
+    
+    void clean()
+    {
+        // No events follow the end of the simulation
+        send_bound(sc_max_time());
+        // The buffers of the null messages outlive the simulation
+        for (auto it=nulls.begin();it!=nulls.end();it++)
+            MPI_Request_free(&it->request);
+        delete msg;
+    }
+    
+    //! Sends a null message if it raises the bound
+    /*! The message is sent without blocking, since the receiving rank may
+     * itself be sending its null messages. The sends which have completed
+     * are retired before each new one.
+     */
+    void send_bound(const sc_time& bound)
+    {
+        if (bound <= sent) return;
+        sent = bound;
+        while (!nulls.empty())
+        {
+            int flag;
+            MPI_Test(&nulls.front().request, &flag, MPI_STATUS_IGNORE);
+            if (!flag) break;
+            nulls.pop_front();
+        }
+        nulls.emplace_back();
+        null_message& null = nulls.back();
+        null.msg.assign(1, message(bound.value(), {}));
+        const void* data;
+        int count;
+        MPI_Datatype type;
+        pack_message(null.msg, null.buf, data, count, type);
+        MPI_Isend(const_cast<void*>(data), count, type, destination, tag,
+                  MPI_COMM_WORLD, &null.request);
+    }
+    
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundInChans.resize(1);     // only one input port
+        boundInChans[0].port = &iport1;
+    }
+#endif
+};
+
+//! Process constructor for a receiver process with one output
+/*! This class is used to build a processes with one output.
+ * It receives the events sent by a DDE sender via MPI and writes them to
+ * its output signal. The simulated time is only advanced up to the lower
+ * bound received with the last message, so that no event arrives with a
+ * tag which is already in the past.
+ */
+template <typename T0>
+class receiver : public dde_process
+{
+public:
+    DDE_out<T0>  oport1;       ///< port for the output channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from its input port,
+     * applies the user-imlpemented function to it and writes the
+     * results using the output port
+     */
+    receiver(sc_module_name _name,     ///< process name
+           int source,                 ///< MPI rank of the source process
+           int tag                     ///< MPI tag of the message
+         ) : dde_process(_name), oport1("oport1"),
+             source(source), tag(tag)
+    {
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("source",std::to_string(source)));
+        arg_vec.push_back(std::make_tuple("tag",std::to_string(tag)));
+#endif
+    }
+    
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "DDE::receiver";}
+
+private:
+    int source;
+    int tag;
+    
+    //! A message carries the bound and the events
+    typedef std::tuple<sc_dt::uint64,std::vector<ttn_event<T0>>> message;
+    
+    // Inputs and output variables
+    std::vector<char> buf;      ///< serialized events of a message
+    std::vector<message>* msgs;
+    std::vector<ttn_event<T0>>* oevs;
+    sc_time bound;              ///< no later event has an earlier tag
+    
+    //Implementing the abstract semantics
+    void init()
+    {
+        msgs = new std::vector<message>;
+        oevs = new std::vector<ttn_event<T0>>;
+        bound = SC_ZERO_TIME;
+        link_sync::get().bounds.push_back(&bound);
+    }
+    
+    void prep()
+    {
+        oevs->clear();
         while (true)
         {
-            MPI_Test(&request, &flag, &status);
-            if (flag) break; else wait(0,SC_NS);
+            MPI_Status status;
+            int flag;
+            MPI_Iprobe(source, tag, MPI_COMM_WORLD, &flag, &status);
+            if (flag)
+            {
+                unpack_message(source, tag, status, buf, *msgs);
+                for (auto it=msgs->begin();it!=msgs->end();it++)
+                {
+                    bound = std::max(bound, sc_time::from_value(std::get<0>(*it)));
+                    auto& evs = std::get<1>(*it);
+                    oevs->insert(oevs->end(), evs.begin(), evs.end());
+                }
+            }
+            else if (!oevs->empty())
+                return;
+            else if (bound > sc_time_stamp())
+                wait(bound - sc_time_stamp());
+            else
+                link_sync::get().starve(source, tag);
         }
-        *oval1 = temp_val;
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *oval1)
+        oport1.write_n(*oevs);
     }
     
     void clean()
     {
-        delete oval1;
+        delete msgs;
+        delete oevs;
     }
     
 #ifdef FORSYDE_INTROSPECTION
@@ -44,10 +44,12 @@ template <class T0, template <class> class I0If>
 inline sender<T0>* make_sender(const std::string& pName,
     int destination,          ///< MPI rank of the destination process
     int tag,                  ///< MPI tag of the message
-    I0If<T0>& inp1S
+    I0If<T0>& inp1S,
+    unsigned batch=1,         ///< maximum number of tokens per message
+    unsigned lookahead=0      ///< delta cycles to wait for more tokens
     )
 {
-    auto p = new sender<T0>(pName.c_str(), destination, tag);
+    auto p = new sender<T0>(pName.c_str(), destination, tag, batch, lookahead);
     
     (*p).iport1(inp1S);
     
@@ -94,10 +96,12 @@ template <class T0, template <class> class I0If>
 inline sender<T0>* make_sender(const std::string& pName,
     int destination,          ///< MPI rank of the destination process
     int tag,                  ///< MPI tag of the message
-    I0If<T0>& inp1S
+    I0If<T0>& inp1S,
+    unsigned batch=1,         ///< maximum number of tokens per message
+    unsigned lookahead=0      ///< delta cycles to wait for more tokens
     )
 {
-    auto p = new sender<T0>(pName.c_str(), destination, tag);
+    auto p = new sender<T0>(pName.c_str(), destination, tag, batch, lookahead);
     
     (*p).iport1(inp1S);
     
@@ -126,6 +130,58 @@ inline receiver<T0>* make_receiver(const std::string& pName,
 }
 
 
+}
+
+namespace DDE
+{
+
+using namespace sc_core;
+
+//! Helper function to construct a sender process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its output and output signals.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the input and output FIFOs.
+ */
+template <class T0, template <class> class I0If>
+inline sender<T0>* make_sender(const std::string& pName,
+    int destination,          ///< MPI rank of the destination process
+    int tag,                  ///< MPI tag of the message
+    I0If<T0>& inp1S,
+    sc_time lookahead=SC_ZERO_TIME,  ///< lookahead from the receivers
+    unsigned batch=1          ///< maximum number of events per message
+    )
+{
+    auto p = new sender<T0>(pName.c_str(), destination, tag, lookahead, batch);
+    
+    (*p).iport1(inp1S);
+    
+    return p;
+}
+
+//! Helper function to construct a receiver process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its output and output signals.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the input and output FIFOs.
+ */
+template <class T0, template <class> class OIf>
+inline receiver<T0>* make_receiver(const std::string& pName,
+    int source,               ///< MPI rank of the source process
+    int tag,                  ///< MPI tag of the message
+    OIf<T0>& outS
+    )
+{
+    auto p = new receiver<T0>(pName.c_str(), source, tag);
+    
+    (*p).oport1(outS);
+    
+    return p;
+}
+
+
 }
 
 }
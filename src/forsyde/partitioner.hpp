@@ -0,0 +1,385 @@
+/**********************************************************************
+    * partitioner.hpp -- Partitioning process networks over MPI ranks *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing an elaboration pass which distributes the    *
+    *          processes of a model among the ranks of an MPI run     *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef PARTITIONER_HPP
+#define PARTITIONER_HPP
+
+/*! \file partitioner.hpp
+ * \brief Implements the automatic partitioning of a model over MPI ranks
+ *
+ *  This file includes an optional elaboration pass which splits a
+ * process network into balanced partitions with few signals between
+ * them, simulates one partition in each MPI rank and transfers the
+ * tokens of the signals which cross the partitions using MPI.
+ */
+
+#include <mpi.h>
+#include <vector>
+#include <map>
+#include <deque>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+namespace ForSyDe
+{
+
+using namespace sc_core;
+
+//! An elaboration pass which partitions the processes among MPI ranks
+/*! All ranks elaborate the complete model, in which an instance of the
+ * partitioner is created inside a (composite) module. At the end of
+ * elaboration, the partitioner of each rank collects the processes in
+ * the hierarchy of its parent module and the signals which connect
+ * them, and deterministically computes the same partitioning of this
+ * graph into as many parts as there are ranks.
+ *
+ * The weight of each process is one, or its profiled time if a profile
+ * written by a run with FORSYDE_PROFILE is given. Similarly, the weight
+ * of each signal is one, or the number of tokens its writer produced in
+ * the profiled run. The graph is first split by growing the partitions
+ * in breadth-first order, so that each receives a connected part of the
+ * graph with a fair share of the total weight. The partitions are then
+ * refined by moving single processes to the partitions of their
+ * neighbors as long as this reduces the weight of the cut signals and
+ * keeps the partitions within the allowed imbalance.
+ *
+ * Each rank simulates only the processes of its own partition. The
+ * processes of the other partitions are remote and never run. For each
+ * signal whose writer and reader are in different partitions, the rank
+ * of the writer forwards the tokens written to the signal to the rank of
+ * the reader, which writes them to its own copy of the signal. Each such
+ * signal is transmitted with its own MPI tag, counted from the given
+ * base tag.
+ *
+ * Only untimed models are supported, since the ranks do not synchronize
+ * their simulated times, and the CT, DDE, DT and MI processes are
+ * rejected. The profile is read by rank 0 and broadcast to the other
+ * ranks, so that it only needs to be readable by rank 0. The
+ * partitioner should be created before any
+ * static scheduler or comb fusion pass, so that these only handle the
+ * local processes.
+ */
+class partitioner : public sc_module
+{
+public:
+    //! The constructor requires the module name
+    partitioner(sc_module_name _name,       ///< The name of the pass
+                const std::string& profile="",  ///< profile CSV file used for the weights
+                unsigned batch=1,           ///< maximum number of tokens per message
+                double imbalance=0.1,       ///< allowed excess weight of a partition
+                int base_tag=1000           ///< the MPI tag of the first cut signal
+               ) : sc_module(_name), profile(profile), batch(batch),
+                   imbalance(imbalance), base_tag(base_tag)
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+    }
+
+    //! The partitioner is not a ForSyDe process and is skipped by introspection
+    virtual const char* kind() const {return "forsyde_partitioner";}
+
+    //! The partitioned processes
+    const std::vector<process*>& processes() const {return procs;}
+
+    //! The partition (i.e., the MPI rank) of each process in processes()
+    const std::vector<int>& partitions() const {return part;}
+
+    //! The total weight of the signals between different partitions
+    double cut_weight() const
+    {
+        double cut = 0;
+        for (auto it=edges.begin();it!=edges.end();it++)
+            if (part[it->src] != part[it->dst]) cut += it->weight;
+        return cut;
+    }
+
+private:
+    //! A signal between two processes
+    struct edge
+    {
+        size_t src, dst;            ///< indices of the writer and the reader
+        untyped_port *oport, *iport;///< ports of the writer and the reader
+        int ochan, ichan;           ///< index of the signal in the ports
+        double weight;
+    };
+
+    std::string profile;
+    unsigned batch;
+    double imbalance;
+    int base_tag;
+    int rank, ranks;
+
+    std::vector<process*> procs;
+    std::vector<double> weights;
+    std::vector<edge> edges;
+    std::vector<int> part;
+
+    //! This hook is used to partition the model and link the partitions
+    void end_of_elaboration()
+    {
+        sc_object* top = get_parent_object();
+        if (top != NULL)
+            collect(top->get_child_objects());
+        else
+            collect(sc_get_top_level_objects());
+
+        build_graph();
+        read_profile();
+        grow_partitions();
+        refine_partitions();
+
+        for (size_t i=0; i<procs.size(); i++)
+            if (part[i] != rank)
+            {
+                procs[i]->externally_scheduled = true;
+                procs[i]->remote = true;
+            }
+
+        int tag = base_tag;
+        for (auto it=edges.begin();it!=edges.end();it++)
+        {
+            if (part[it->src] == part[it->dst]) continue;
+            edge e = *it;
+            int src = part[e.src], dst = part[e.dst];
+            // The port of the remote process is used by the link instead
+            if (src == rank)
+                sc_spawn([e, dst, tag, this]() {e.iport->mpi_link(e.ichan, dst, tag, batch);},
+                         sc_gen_unique_name("send"));
+            else if (dst == rank)
+                sc_spawn([e, src, tag, this]() {e.oport->mpi_link(e.ochan, src, tag, batch);},
+                         sc_gen_unique_name("recv"));
+            tag++;
+        }
+    }
+
+    //! Recursively collects the processes
+    void collect(const std::vector<sc_object*>& objs)
+    {
+        for (auto it=objs.begin();it!=objs.end();it++)
+        {
+            if (process* p = dynamic_cast<process*>(*it))
+            {
+                if (p->externally_scheduled) continue;
+                std::string moc = p->forsyde_kind();
+                moc = moc.substr(0, moc.find("::"));
+                if (moc=="CT" || moc=="DDE" || moc=="DT" || moc=="MI")
+                    SC_REPORT_ERROR(name(), ("timed process " + std::string(p->name())
+                                    + " cannot be partitioned").c_str());
+                procs.push_back(p);
+            }
+            else if (dynamic_cast<sc_module*>(*it) != NULL)
+                collect((*it)->get_child_objects());
+        }
+    }
+
+    //! Finds the signals which connect two of the processes
+    void build_graph()
+    {
+        std::map<sc_interface*, std::tuple<size_t,untyped_port*,int>> readers;
+        for (size_t i=0; i<procs.size(); i++)
+        {
+            const std::vector<sc_object*>& ports = procs[i]->get_child_objects();
+            for (auto it=ports.begin();it!=ports.end();it++)
+            {
+                untyped_port* port = dynamic_cast<untyped_port*>(*it);
+                if (port == NULL || !port->is_input()) continue;
+                for (int c=0; c<port->channel_count(); c++)
+                    readers[port->channel(c)] = std::make_tuple(i, port, c);
+            }
+        }
+
+        for (size_t i=0; i<procs.size(); i++)
+        {
+            const std::vector<sc_object*>& ports = procs[i]->get_child_objects();
+            for (auto it=ports.begin();it!=ports.end();it++)
+            {
+                untyped_port* port = dynamic_cast<untyped_port*>(*it);
+                if (port == NULL || port->is_input()) continue;
+                for (int c=0; c<port->channel_count(); c++)
+                {
+                    auto rd = readers.find(port->channel(c));
+                    if (rd == readers.end()) continue;
+                    edges.push_back({i, std::get<0>(rd->second), port,
+                                     std::get<1>(rd->second), c,
+                                     std::get<2>(rd->second), 1.0});
+                }
+            }
+        }
+    }
+
+    //! Reads the weights of the processes and signals from a profile
+    /*! A process is weighted by the time spent in its stages and a signal
+     * by the tokens produced by its writer divided among its signals.
+     * Only rank 0 reads the profile and broadcasts the weights, so that
+     * all ranks compute the same partitions.
+     */
+    void read_profile()
+    {
+        weights.assign(procs.size(), 1.0);
+        if (profile.empty()) return;
+        std::vector<double> eweights(edges.size(), 1.0);
+        int ok = rank != 0 || parse_profile(eweights);
+        MPI_Bcast(&ok, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (!ok)
+            SC_REPORT_ERROR(name(), ("cannot open the profile " + profile).c_str());
+        MPI_Bcast(weights.data(), weights.size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        MPI_Bcast(eweights.data(), eweights.size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        for (size_t i=0; i<edges.size(); i++)
+            edges[i].weight = eweights[i];
+    }
+
+    //! Parses the profile into the weights, returns false if it cannot be opened
+    bool parse_profile(std::vector<double>& eweights)
+    {
+        std::ifstream csv(profile);
+        if (!csv.is_open()) return false;
+        std::map<std::string, std::pair<double,double>> prof;
+        std::string line;
+        std::getline(csv, line);    // the header
+        while (std::getline(csv, line))
+        {
+            std::vector<std::string> fields;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, ',')) fields.push_back(field);
+            if (fields.size() < 9) continue;
+            double time = std::stod(fields[3]) + std::stod(fields[4]) + std::stod(fields[5]);
+            prof[fields[0]] = std::make_pair(time, std::stod(fields[8]));
+        }
+
+        std::vector<unsigned> outs(procs.size(), 0);
+        for (auto it=edges.begin();it!=edges.end();it++)
+            outs[it->src]++;
+        for (size_t i=0; i<procs.size(); i++)
+        {
+            auto pr = prof.find(procs[i]->name());
+            if (pr != prof.end()) weights[i] = pr->second.first;
+        }
+        for (size_t i=0; i<edges.size(); i++)
+        {
+            auto pr = prof.find(procs[edges[i].src]->name());
+            if (pr != prof.end()) eweights[i] = pr->second.second / outs[edges[i].src];
+        }
+        // Processes which never fired still occupy a thread
+        double total = 0;
+        for (size_t i=0; i<procs.size(); i++) total += weights[i];
+        for (size_t i=0; i<procs.size(); i++)
+            weights[i] = std::max(weights[i], total * 1e-6);
+        return true;
+    }
+
+    //! The neighbors of each process as pairs of process and edge weight
+    std::vector<std::vector<std::pair<size_t,double>>> neighbors() const
+    {
+        std::vector<std::vector<std::pair<size_t,double>>> adj(procs.size());
+        for (auto it=edges.begin();it!=edges.end();it++)
+        {
+            adj[it->src].push_back(std::make_pair(it->dst, it->weight));
+            adj[it->dst].push_back(std::make_pair(it->src, it->weight));
+        }
+        return adj;
+    }
+
+    //! Assigns the processes to the partitions in breadth-first order
+    void grow_partitions()
+    {
+        size_t n = procs.size();
+        auto adj = neighbors();
+        double total = 0;
+        for (size_t i=0; i<n; i++) total += weights[i];
+
+        std::vector<size_t> order;
+        std::vector<bool> seen(n, false);
+        for (size_t root=0; root<n; root++)
+        {
+            if (seen[root]) continue;
+            std::deque<size_t> queue(1, root);
+            seen[root] = true;
+            while (!queue.empty())
+            {
+                size_t i = queue.front();
+                queue.pop_front();
+                order.push_back(i);
+                for (auto it=adj[i].begin();it!=adj[i].end();it++)
+                    if (!seen[it->first])
+                    {
+                        seen[it->first] = true;
+                        queue.push_back(it->first);
+                    }
+            }
+        }
+
+        part.assign(n, 0);
+        double acc = 0;
+        for (auto it=order.begin();it!=order.end();it++)
+        {
+            // The partition which contains the middle of the process weight
+            int p = (acc + weights[*it]/2) * ranks / total;
+            part[*it] = std::min(p, ranks-1);
+            acc += weights[*it];
+        }
+    }
+
+    //! Moves processes between partitions while the cut weight decreases
+    void refine_partitions()
+    {
+        size_t n = procs.size();
+        if (ranks < 2 || n == 0) return;
+        auto adj = neighbors();
+        double total = 0;
+        std::vector<double> load(ranks, 0);
+        for (size_t i=0; i<n; i++)
+        {
+            total += weights[i];
+            load[part[i]] += weights[i];
+        }
+        double limit = total / ranks * (1 + imbalance);
+
+        bool moved = true;
+        for (int pass=0; pass<10 && moved; pass++)
+        {
+            moved = false;
+            for (size_t i=0; i<n; i++)
+            {
+                // The weight of the edges of the process to each partition
+                std::map<int,double> conn;
+                for (auto it=adj[i].begin();it!=adj[i].end();it++)
+                    conn[part[it->first]] += it->second;
+                double own = conn[part[i]];
+                int best = part[i];
+                double gain = 0;
+                for (auto it=conn.begin();it!=conn.end();it++)
+                {
+                    double g = it->second - own;
+                    if (it->first != part[i] && g > gain &&
+                        load[it->first] + weights[i] <= limit)
+                    {
+                        best = it->first;
+                        gain = g;
+                    }
+                }
+                if (best == part[i]) continue;
+                load[part[i]] -= weights[i];
+                load[best] += weights[i];
+                part[i] = best;
+                moved = true;
+            }
+        }
+    }
+};
+
+}
+
+#endif
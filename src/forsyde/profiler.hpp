@@ -0,0 +1,122 @@
+/**********************************************************************
+    * profiler.hpp -- Profiling the firings of ForSyDe processes      *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Collecting execution statistics for each process       *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+/*! \file profiler.hpp
+ * \brief Implements an optional per-process firing profiler
+ *
+ *  This file includes the data structures used to record, for each
+ * process, the number of firings, the wall-clock time spent in each
+ * stage of the abstract semantics, the number of transferred tokens and
+ * the time spent blocked on the signals. The profiler is enabled by
+ * defining the FORSYDE_PROFILE macro, and otherwise adds no code to the
+ * processes and signals.
+ *
+ * The statistics are written at the end of the simulation to the files
+ * FORSYDE_PROFILE_FILE.csv and FORSYDE_PROFILE_FILE.json (by default
+ * forsyde_profile.csv and forsyde_profile.json).
+ *
+ * Note that the stage times are wall-clock times, so a process which
+ * waits for time to advance (e.g., in the DDE and CT MoCs) also counts
+ * the time spent by the other processes meanwhile. The processes of a
+ * fused chain of SY processes are profiled as its first process.
+ */
+
+#ifdef FORSYDE_PROFILE
+
+#include <chrono>
+#include <cstddef>
+
+#ifndef FORSYDE_PROFILE_FILE
+#define FORSYDE_PROFILE_FILE "forsyde_profile"
+#endif
+
+namespace ForSyDe
+{
+
+//! The execution statistics of a process
+struct process_profile
+{
+    typedef std::chrono::steady_clock clock;
+
+    //! Number of firings
+    unsigned long long firings = 0;
+    //! Time spent in the prep, exec and prod stages, excluding the time blocked on signals
+    clock::duration stages[3] = {};
+    //! Time spent blocked on reading from or writing to signals
+    clock::duration blocked{};
+    //! Number of tokens read from the input signals
+    unsigned long long consumed = 0;
+    //! Number of tokens written to the output signals
+    unsigned long long produced = 0;
+
+    //! The profile of the latest process fired by a static scheduler
+    static inline process_profile* active = NULL;
+    //! The static scheduler which has fired the active process
+    static inline const sc_core::sc_object* active_host = NULL;
+};
+
+//! The profile of the process which is currently running
+/*! If the running SystemC process belongs to a static scheduler, the
+ * profile of the process it has fired latest is returned. The other
+ * SystemC processes which are not ForSyDe processes (e.g., testbench
+ * threads and MPI links) are not profiled, and NULL is returned.
+ */
+inline process_profile* current_profile();
+
+//! Records a token transfer on a signal by the running process
+/*! The object measures the time until it is destroyed if the transfer
+ * is expected to block.
+ */
+class profile_transfer
+{
+public:
+    profile_transfer(bool input, size_t toks, bool blocks)
+        : prof(current_profile()), input(input), toks(toks), blocks(blocks)
+    {
+        if (prof != NULL && blocks) start = process_profile::clock::now();
+    }
+
+    //! The tokens are counted once the transfer is complete
+    ~profile_transfer()
+    {
+        if (prof == NULL) return;
+        if (input) prof->consumed += toks;
+        else prof->produced += toks;
+        if (blocks) prof->blocked += process_profile::clock::now() - start;
+    }
+
+private:
+    process_profile* prof;
+    bool input;
+    size_t toks;
+    bool blocks;
+    process_profile::clock::time_point start;
+};
+
+}
+
+#define FORSYDE_PROFILE_CONSUME(N, BLOCKS) \
+    ForSyDe::profile_transfer forsyde_profile_transfer(true, N, BLOCKS)
+#define FORSYDE_PROFILE_PRODUCE(N, BLOCKS) \
+    ForSyDe::profile_transfer forsyde_profile_transfer(false, N, BLOCKS)
+
+#else
+
+#define FORSYDE_PROFILE_CONSUME(N, BLOCKS)
+#define FORSYDE_PROFILE_PRODUCE(N, BLOCKS)
+
+#endif
+
+#endif
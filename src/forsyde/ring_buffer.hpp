@@ -0,0 +1,235 @@
+/**********************************************************************
+    * ring_buffer.hpp -- Plain token buffers used by ForSyDe channels *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing light-weight FIFO storage which is accessed  *
+    *          without involving the SystemC kernel                   *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+/*! \file ring_buffer.hpp
+ * \brief Implements ring buffers for storing tokens
+ *
+ *  This file provides a plain growable FIFO buffer which is used by
+ * ForSyDe channels when they are driven directly by a static scheduler,
+ * and a bounded single-producer single-consumer ring buffer which is
+ * used by ring-buffer channels.
+ */
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace ForSyDe
+{
+
+//! A growable ring buffer with a power-of-two capacity
+/*! Tokens are stored in a contiguous vector which is indexed using a
+ * mask. The buffer doubles its capacity when it becomes full, so a
+ * writer never blocks.
+ */
+template <typename T>
+class ring_buffer
+{
+public:
+    //! The constructor takes the initial capacity, rounded up to a power of two
+    ring_buffer(size_t capacity=16) : head(0), tail(0)
+    {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        buf.resize(cap);
+        mask = cap - 1;
+    }
+
+    //! Number of tokens stored in the buffer
+    size_t size() const {return tail - head;}
+
+    //! Checks if the buffer is empty
+    bool empty() const {return head == tail;}
+
+    //! Current capacity of the buffer
+    size_t capacity() const {return buf.size();}
+
+    //! Appends a token to the end of the buffer
+    void push(const T& val)
+    {
+        if (size() == buf.size()) grow();
+        buf[tail++ & mask] = val;
+    }
+
+    //! Moves a token to the end of the buffer
+    void push(T&& val)
+    {
+        if (size() == buf.size()) grow();
+        buf[tail++ & mask] = std::move(val);
+    }
+
+    //! Removes the token at the front of the buffer and returns it
+    T pop()
+    {
+        return std::move(buf[head++ & mask]);
+    }
+
+    //! Returns the token at the front of the buffer
+    const T& front() const
+    {
+        return buf[head & mask];
+    }
+
+    //! Removes all tokens from the buffer
+    void clear() {head = tail = 0;}
+
+private:
+    std::vector<T> buf;
+    size_t mask;
+    size_t head, tail;      // free-running read and write counters
+
+    //! Doubles the capacity while preserving the order of the tokens
+    void grow()
+    {
+        std::vector<T> nbuf(buf.size()*2);
+        size_t n = size();
+        for (size_t i=0; i<n; i++)
+            nbuf[i] = std::move(buf[(head+i) & mask]);
+        buf.swap(nbuf);
+        mask = buf.size() - 1;
+        head = 0;
+        tail = n;
+    }
+};
+
+//! Size of a cache line, used to keep the producer and consumer apart
+#define FORSYDE_CACHE_LINE 64
+
+//! A bounded lock-free single-producer single-consumer ring buffer
+/*! The capacity is rounded up to a power of two. The write counter is
+ * only modified by the producer and the read counter only by the
+ * consumer, and each of them lives in its own cache line together with
+ * a private copy of the other counter. Hence, the two sides only touch
+ * the shared counters when the cached copy suggests the buffer is full
+ * (or empty).
+ */
+template <typename T>
+class spsc_ring
+{
+public:
+    //! The constructor takes the capacity, rounded up to a power of two
+    spsc_ring(size_t capacity=16) : head(0), tail_cache(0), tail(0), head_cache(0)
+    {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        buf.resize(cap);
+        mask = cap - 1;
+    }
+
+    //! Number of tokens stored in the buffer
+    size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    //! Checks if the buffer is empty
+    bool empty() const {return size() == 0;}
+
+    //! Checks if the buffer is full
+    bool full() const {return size() == buf.size();}
+
+    //! The capacity of the buffer
+    size_t capacity() const {return buf.size();}
+
+    //! Appends a token to the buffer, fails if it is full (producer side)
+    bool push(const T& val)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head_cache == buf.size())
+        {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t - head_cache == buf.size()) return false;
+        }
+        buf[t & mask] = val;
+        tail.store(t+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Moves a token to the buffer, fails if it is full (producer side)
+    /*! The token is left untouched if the buffer is full.
+     */
+    bool push(T&& val)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head_cache == buf.size())
+        {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t - head_cache == buf.size()) return false;
+        }
+        buf[t & mask] = std::move(val);
+        tail.store(t+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Appends up to n tokens to the buffer and returns the number of appended tokens (producer side)
+    /*! The tokens are moved if a move iterator is passed.
+     */
+    template <typename It>
+    size_t push_n(It vals, size_t n)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (buf.size() - (t - head_cache) < n)
+            head_cache = head.load(std::memory_order_acquire);
+        size_t cnt = std::min(n, buf.size() - (t - head_cache));
+        for (size_t i=0; i<cnt; i++)
+            buf[(t+i) & mask] = vals[i];
+        tail.store(t+cnt, std::memory_order_release);
+        return cnt;
+    }
+
+    //! Removes the token at the front of the buffer, fails if it is empty (consumer side)
+    bool pop(T& val)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail_cache)
+        {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (h == tail_cache) return false;
+        }
+        val = std::move(buf[h & mask]);
+        head.store(h+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Removes up to n tokens from the buffer and returns the number of removed tokens (consumer side)
+    size_t pop_n(T* vals, size_t n)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (tail_cache - h < n)
+            tail_cache = tail.load(std::memory_order_acquire);
+        size_t cnt = std::min(n, tail_cache - h);
+        for (size_t i=0; i<cnt; i++)
+            vals[i] = std::move(buf[(h+i) & mask]);
+        head.store(h+cnt, std::memory_order_release);
+        return cnt;
+    }
+
+private:
+    std::vector<T> buf;
+    size_t mask;
+    // consumer side: the read counter and a copy of the write counter
+    alignas(FORSYDE_CACHE_LINE) std::atomic<size_t> head;
+    size_t tail_cache;
+    // producer side: the write counter and a copy of the read counter
+    alignas(FORSYDE_CACHE_LINE) std::atomic<size_t> tail;
+    size_t head_cache;
+};
+
+}
+
+#endif
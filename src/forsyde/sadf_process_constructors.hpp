@@ -123,8 +123,7 @@ private:
         o1vals.resize(prod_rate);
 
         // Reading the input port
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(i1vals);
     }
     
     void exec()
@@ -135,7 +134,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
         i1vals.clear();
     }
@@ -244,10 +243,8 @@ private:
         o1vals.resize(prod_rate);
 
         // Reading the input ports
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
     }
     
     void exec()
@@ -258,7 +255,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
         i1vals.clear();
         i2vals.clear();
@@ -388,12 +385,7 @@ private:
         // Reading the input ports        
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, ivals);
         }, iport);
     }
@@ -418,7 +410,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, ovals);
         }, oport);
     }
@@ -543,8 +535,7 @@ private:
     void prep()
     {
         // Reading the input port according to the input tokens consumption rate which is passed to the constructor
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(i1vals);
     }
     
     void exec()
@@ -566,7 +557,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
     }
     
     void clean()
@@ -698,12 +689,7 @@ private:
         // Reading the input ports        
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, ivals);
         }, iport);
     }
@@ -733,7 +719,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, ovals);
         }, oport);
 #ifdef FORSYDE_SELF_REPORTING
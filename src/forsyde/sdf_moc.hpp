@@ -27,6 +27,7 @@
 #include "sdf_process.hpp"
 #include "sdf_process_constructors.hpp"
 #include "sdf_helpers.hpp"
+#include "sdf_scheduler.hpp"
 
 namespace ForSyDe
 {
@@ -20,6 +20,8 @@
  * abstract base process used in the SDF MoC.
  */
 
+#include <vector>
+
 #include "abssemantics.hpp"
 
 namespace ForSyDe
@@ -90,8 +92,46 @@ public:
 template <typename T>
 using out_port = SDF_out<T>;
 
-//! Abstract semantics of a process in the SY MoC
-typedef ForSyDe::process sdf_process;
+class static_scheduler;
+
+//! Abstract semantics of a process in the SDF MoC
+/*! In addition to the common abstract semantics, an SDF process can
+ * report the consumption and production rates of its ports. This is
+ * used by the static scheduler to compute a periodic schedule and fire
+ * the process directly instead of running its thread.
+ */
+class sdf_process : public ForSyDe::process
+{
+public:
+    sdf_process(sc_module_name _name) : process(_name) {}
+    
+    //! Pointers to the input ports and their consumption rates
+    std::vector<PortInfo> inRates;
+    //! Pointers to the output ports and their production rates
+    std::vector<PortInfo> outRates;
+
+protected:
+    friend class static_scheduler;
+    
+    //! This method is called by the static scheduler to gather the port rates
+    /*! This function should save the pointers to the input and output
+     * ports together with their token rates in inRates and outRates
+     * respectively. Processes which do not report any rates keep their
+     * own thread and are not fired by the static scheduler.
+     */
+    virtual void rateInfo() {}
+    
+#ifdef FORSYDE_COROUTINES
+    //! The port rates are reused to check if the process can run as a coroutine
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        rateInfo();
+        ins = inRates;
+        outs = outRates;
+        return !inRates.empty() || !outRates.empty();
+    }
+#endif
+};
 
 }
 }
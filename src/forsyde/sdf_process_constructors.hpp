@@ -40,8 +40,13 @@ using namespace sc_core;
 /*! This class is used to build combinational processes with one input
  * and one output. The class is parameterized for input and output
  * data-types.
+ * The type of the function defaults to std::function and can be set
+ * to any other callable type (see make_comb) to let the compiler inline
+ * it into the process.
  */
-template <typename T0, typename T1>
+template <typename T0, typename T1,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&)>>
 class comb : public sdf_process
 {
 public:
@@ -49,9 +54,7 @@ public:
     SDF_out<T0> oport1;       ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name ad the number of tokens to be produced
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -97,8 +100,7 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(i1vals);
     }
     
     void exec()
@@ -108,11 +110,21 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
     }
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = i1toks;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = o1toks;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -127,7 +139,10 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2>
+template <typename T0, typename T1, typename T2,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&)>>
 class comb2 : public sdf_process
 {
 public:
@@ -136,10 +151,7 @@ public:
     SDF_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -188,10 +200,8 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
     }
     
     void exec()
@@ -201,11 +211,23 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
     }
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(2);
+        inRates[0].port = &iport1;
+        inRates[0].toks = i1toks;
+        inRates[1].port = &iport2;
+        inRates[1].toks = i2toks;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = o1toks;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -221,7 +243,11 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2, typename T3>
+template <typename T0, typename T1, typename T2, typename T3,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&,
+                                                 const std::vector<T3>&)>>
 class comb3 : public sdf_process
 {
 public:
@@ -231,11 +257,7 @@ public:
     SDF_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&,
-                                const std::vector<T3>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -289,12 +311,9 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
-        for (auto it=i3vals.begin();it!=i3vals.end();it++)
-            *it = iport3.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
+        iport3.read_n(i3vals);
     }
     
     void exec()
@@ -304,11 +323,25 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
     }
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(3);
+        inRates[0].port = &iport1;
+        inRates[0].toks = i1toks;
+        inRates[1].port = &iport2;
+        inRates[1].toks = i2toks;
+        inRates[2].port = &iport3;
+        inRates[2].toks = i3toks;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = o1toks;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -325,7 +358,12 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2, typename T3, typename T4>
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&,
+                                                 const std::vector<T3>&,
+                                                 const std::vector<T4>&)>>
 class comb4 : public sdf_process
 {
 public:
@@ -336,12 +374,7 @@ public:
     SDF_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&,
-                                const std::vector<T3>&,
-                                const std::vector<T4>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -400,14 +433,10 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
-        for (auto it=i3vals.begin();it!=i3vals.end();it++)
-            *it = iport3.read();
-        for (auto it=i4vals.begin();it!=i4vals.end();it++)
-            *it = iport4.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
+        iport3.read_n(i3vals);
+        iport4.read_n(i4vals);
     }
     
     void exec()
@@ -417,11 +446,27 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
     }
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(4);
+        inRates[0].port = &iport1;
+        inRates[0].toks = i1toks;
+        inRates[1].port = &iport2;
+        inRates[1].toks = i2toks;
+        inRates[2].port = &iport3;
+        inRates[2].toks = i3toks;
+        inRates[3].port = &iport4;
+        inRates[3].toks = i4toks;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = o1toks;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -511,12 +556,7 @@ private:
     {
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, ivals);
         }, iport);
     }
@@ -530,13 +570,35 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, ovals);
         }, oport);
     }
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(sizeof...(TIs));
+        std::apply
+        (
+            [&](auto&... ports)
+            {
+                std::size_t n{0};
+                ((inRates[n].port = &ports, inRates[n].toks = itoks[n], n++),...);
+            }, iport
+        );
+        outRates.resize(sizeof...(TOs));
+        std::apply
+        (
+            [&](auto&... ports)
+            {
+                std::size_t n{0};
+                ((outRates[n].port = &ports, outRates[n].toks = otoks[n], n++),...);
+            }, oport
+        );
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -622,13 +684,23 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
     {
         delete val;
     }
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -702,13 +774,32 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
     {
         delete val;
     }
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
+#ifdef FORSYDE_COROUTINES
+    // The init stage writes n tokens, which blocks when they do not fit
+    // in the channel, so the process keeps its own thread
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        return false;
+    }
+#endif
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -764,7 +855,7 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 0;
     }
     
@@ -781,6 +872,13 @@ private:
     
     void clean() {}
 
+    void rateInfo()
+    {
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -847,7 +945,7 @@ private:
         cur_st = new T;
         *cur_st = init_st;
         write_multiport(oport1, *cur_st);
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 1;
     }
     
@@ -870,6 +968,13 @@ private:
         delete cur_st;
     }
     
+    void rateInfo()
+    {
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -962,6 +1067,13 @@ private:
         delete cur_val;
     }
     
+    void rateInfo()
+    {
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1028,6 +1140,13 @@ private:
     
     void clean() {}
     
+    void rateInfo()
+    {
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1072,7 +1191,7 @@ public:
     std::string forsyde_kind() const {return "SDF::sink";}
     
 private:
-    T* val;         // The current state of the process
+    token_view<T>* val;   // The current input of the process
 
     //! The function passed to the process constructor
     functype _func;
@@ -1080,17 +1199,17 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        val = new T;
+        val = new token_view<T>;
     }
     
     void prep()
     {
-        *val = iport1.read();
+        iport1.read_view(*val);
     }
     
     void exec()
     {
-        _func(*val);
+        _func(**val);
     }
     
     void prod() {}
@@ -1100,6 +1219,13 @@ private:
         delete val;
     }
     
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1189,6 +1315,13 @@ private:
         delete cur_val;
     }
     
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1291,10 +1424,8 @@ private:
     
     void prep()
     {
-        for (auto i=0; i<i1toks; i++)
-            ival1[i] = iport1.read();
-        for (auto i=0; i<i2toks; i++)
-            ival2[i] = iport2.read();    
+        iport1.read_n(ival1);
+        iport2.read_n(ival2);
     }
     
     void exec() {}
@@ -1306,6 +1437,18 @@ private:
     
     void clean() {}
     
+    void rateInfo()
+    {
+        inRates.resize(2);
+        inRates[0].port = &iport1;
+        inRates[0].toks = i1toks;
+        inRates[1].port = &iport2;
+        inRates[1].toks = i2toks;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1364,12 +1507,7 @@ private:
     {
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, *in_val);
         }, iport);
     }
@@ -1378,7 +1516,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1,*in_val);    // write to the output;
+        write_multiport(oport1,std::move(*in_val));    // write to the output;
     }
     
     void clean()
@@ -1386,6 +1524,22 @@ private:
         delete in_val;
     }
 
+    void rateInfo()
+    {
+        inRates.resize(sizeof...(Ts));
+        std::apply
+        (
+            [&](auto&... ports)
+            {
+                std::size_t n{0};
+                ((inRates[n].port = &ports, inRates[n].toks = in_toks[n], n++),...);
+            }, iport
+        );
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1457,8 +1611,8 @@ private:
     void prod()
     {
         
-        write_vec_multiport(oport1,std::get<0>(*in_val));  // write to the output 1
-        write_vec_multiport(oport2,std::get<1>(*in_val));  // write to the output 2
+        oport1.move_n(std::get<0>(*in_val));  // write to the output 1
+        oport2.move_n(std::get<1>(*in_val));  // write to the output 2
     }
     
     void clean()
@@ -1466,6 +1620,18 @@ private:
         delete in_val;
     }
     
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+        outRates.resize(2);
+        outRates[0].port = &oport1;
+        outRates[0].toks = o1toks;
+        outRates[1].port = &oport2;
+        outRates[1].toks = o2toks;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1531,7 +1697,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, *in_val);
         }, oport);
     }
@@ -1541,6 +1707,22 @@ private:
         delete in_val;
     }
  
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+        outRates.resize(sizeof...(Ts));
+        std::apply
+        (
+            [&](auto&... ports)
+            {
+                std::size_t n{0};
+                ((outRates[n].port = &ports, outRates[n].toks = out_toks[n], n++),...);
+            }, oport
+        );
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -1587,31 +1769,38 @@ public:
     std::string forsyde_kind() const {return "SDF::fanout";}
     
 private:
-    // Inputs and output variables
-    T* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const T> val;
     
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new T;
-    }
+    void init() {}
     
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
     }
     
     void clean()
     {
-        delete val;
+        val.reset();
     }
+    void rateInfo()
+    {
+        inRates.resize(1);
+        inRates[0].port = &iport1;
+        inRates[0].toks = 1;
+        outRates.resize(1);
+        outRates[0].port = &oport1;
+        outRates[0].toks = 1;
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
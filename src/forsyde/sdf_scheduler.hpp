@@ -0,0 +1,303 @@
+/**********************************************************************
+    * sdf_scheduler.hpp -- Static scheduling of SDF process networks  *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing a static scheduler which fires SDF processes *
+    *          from a single thread                                   *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SDF_SCHEDULER_HPP
+#define SDF_SCHEDULER_HPP
+
+/*! \file sdf_scheduler.hpp
+ * \brief Implements a static scheduler for the SDF MoC
+ *
+ *  This file includes an optional execution engine which computes a
+ * periodic admissible sequential schedule (PASS) for a network of SDF
+ * processes and fires them directly from a single thread.
+ */
+
+#include <vector>
+#include <map>
+#include <numeric>
+
+#include "sdf_process.hpp"
+
+namespace ForSyDe
+{
+
+namespace SDF
+{
+
+using namespace sc_core;
+
+//! A static scheduler which fires SDF processes from a single thread
+/*! When instantiated inside a (composite) module, the scheduler takes
+ * over all SDF processes found in the hierarchy of its parent module.
+ * At the end of elaboration it collects the token rates of their ports,
+ * computes the repetition vector of the graph and switches the signals
+ * which connect two scheduled processes to the direct mode.
+ *
+ * During the simulation, the threads of the scheduled processes
+ * terminate immediately and the scheduler runs their init stages and
+ * then repeatedly fires them in the order of a periodic admissible
+ * sequential schedule by calling their prep, exec and prod stages.
+ * The scheduler yields to the SystemC kernel once per period.
+ *
+ * Signals which connect a scheduled process to the rest of the model
+ * remain normal FIFOs and the scheduler blocks on them as a single
+ * process would. Hence, the scheduled processes should only communicate
+ * with the rest of the model in a feed-forward manner. Two scheduled
+ * processes should be connected through ForSyDe signals; any other
+ * channel between them is reported as an error.
+ *
+ * The scheduled processes fire in exactly the same order relative to
+ * their own inputs, so the produced values are identical to the
+ * threaded execution. The schedule stops when a scheduled process
+ * suspends (e.g., when a finite source runs out of tokens).
+ */
+class static_scheduler : public sc_module
+{
+public:
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which fires the scheduled processes.
+     */
+    static_scheduler(sc_module_name _name     ///< The name of the scheduler
+                    ) : sc_module(_name)
+    {
+        SC_THREAD(worker);
+    }
+
+    //! The scheduler is not a ForSyDe process and is skipped by introspection
+    virtual const char* kind() const {return "forsyde_static_scheduler";}
+
+    //! The processes fired by the scheduler
+    const std::vector<sdf_process*>& processes() const {return actors;}
+
+    //! Number of firings of each process in one period of the schedule
+    const std::vector<unsigned long>& repetitions() const {return reps;}
+
+    //! The periodic schedule as a sequence of indices into processes()
+    /*! The schedule is computed at the beginning of the simulation, after
+     * the init stages of the processes has produced the initial tokens.
+     */
+    const std::vector<size_t>& schedule() const {return sched;}
+
+private:
+    SC_HAS_PROCESS(static_scheduler);
+
+    //! A signal which connects two scheduled processes
+    struct edge
+    {
+        size_t src, dst;        ///< indices of the writer and the reader
+        unsigned prod, cons;    ///< production and consumption rates
+        direct_channel* chan;   ///< the signal
+    };
+
+    std::vector<sdf_process*> actors;
+    std::vector<edge> edges;
+    std::vector<unsigned long> reps;
+    std::vector<size_t> sched;
+
+    //! The main and only execution thread of the scheduler
+    void worker()
+    {
+        if (actors.empty()) return;
+        for (auto it=actors.begin();it!=actors.end();it++)
+            (*it)->init();
+        compute_schedule();
+        while (1)
+        {
+            for (auto it=sched.begin();it!=sched.end();it++)
+                actors[*it]->fire();
+            wait(SC_ZERO_TIME);
+        }
+    }
+
+    //! This hook is used to collect the processes and build the graph
+    void end_of_elaboration()
+    {
+        sc_object* top = get_parent_object();
+        if (top != NULL)
+            collect(top->get_child_objects());
+        else
+            collect(sc_get_top_level_objects());
+
+        build_graph();
+        compute_repetitions();
+
+        for (auto it=actors.begin();it!=actors.end();it++)
+            (*it)->externally_scheduled = true;
+        for (auto it=edges.begin();it!=edges.end();it++)
+            it->chan->make_direct();
+    }
+
+    //! Recursively collects the SDF processes which report their rates
+    void collect(const std::vector<sc_object*>& objs)
+    {
+        for (auto it=objs.begin();it!=objs.end();it++)
+        {
+            if (sdf_process* p = dynamic_cast<sdf_process*>(*it))
+            {
+                if (p->externally_scheduled) continue;
+                p->rateInfo();
+                if (!p->inRates.empty() || !p->outRates.empty())
+                    actors.push_back(p);
+            }
+            else if (dynamic_cast<sc_module*>(*it) != NULL)
+                collect((*it)->get_child_objects());
+        }
+    }
+
+    //! Finds the signals which connect two scheduled processes
+    void build_graph()
+    {
+        std::map<sc_interface*, std::pair<size_t,unsigned>> readers;
+        for (size_t i=0; i<actors.size(); i++)
+            for (auto it=actors[i]->inRates.begin();it!=actors[i]->inRates.end();it++)
+            {
+                untyped_port* port = dynamic_cast<untyped_port*>(it->port);
+                for (int c=0; c<port->channel_count(); c++)
+                    readers[port->channel(c)] = std::make_pair(i, it->toks);
+            }
+
+        for (size_t i=0; i<actors.size(); i++)
+            for (auto it=actors[i]->outRates.begin();it!=actors[i]->outRates.end();it++)
+            {
+                untyped_port* port = dynamic_cast<untyped_port*>(it->port);
+                for (int c=0; c<port->channel_count(); c++)
+                {
+                    auto rd = readers.find(port->channel(c));
+                    direct_channel* chan = dynamic_cast<direct_channel*>(port->channel(c));
+                    // The reader is not fired by the scheduler
+                    if (rd == readers.end()) continue;
+                    // Both ends are fired by the scheduler, which needs to
+                    // track the tokens in the signal
+                    if (chan == NULL)
+                        SC_REPORT_ERROR(name(), "the static scheduler only supports ForSyDe signals between scheduled processes");
+                    if (it->toks == 0 || rd->second.second == 0)
+                        SC_REPORT_ERROR(name(), "zero token rates are not supported by the static scheduler");
+                    edges.push_back({i, rd->second.first, it->toks, rd->second.second, chan});
+                }
+            }
+    }
+
+    //! Solves the balance equations of each connected component
+    void compute_repetitions()
+    {
+        size_t n = actors.size();
+        std::vector<std::vector<size_t>> adj(n);
+        for (size_t e=0; e<edges.size(); e++)
+        {
+            adj[edges[e].src].push_back(e);
+            adj[edges[e].dst].push_back(e);
+        }
+
+        // The firing rates are propagated as fractions num/den
+        std::vector<long long> num(n, 0), den(n, 1);
+        reps.assign(n, 0);
+        for (size_t root=0; root<n; root++)
+        {
+            if (num[root] != 0) continue;
+            std::vector<size_t> comp(1, root);
+            num[root] = 1;
+            for (size_t k=0; k<comp.size(); k++)
+            {
+                size_t a = comp[k];
+                for (auto it=adj[a].begin();it!=adj[a].end();it++)
+                {
+                    const edge& ed = edges[*it];
+                    size_t b;
+                    long long bn, bd;
+                    if (ed.src == a)
+                    {
+                        b = ed.dst;
+                        bn = num[a] * ed.prod;
+                        bd = den[a] * ed.cons;
+                    }
+                    else
+                    {
+                        b = ed.src;
+                        bn = num[a] * ed.cons;
+                        bd = den[a] * ed.prod;
+                    }
+                    long long g = std::gcd(bn, bd);
+                    bn /= g;
+                    bd /= g;
+                    if (num[b] == 0)
+                    {
+                        num[b] = bn;
+                        den[b] = bd;
+                        comp.push_back(b);
+                    }
+                    else if (num[b]*bd != bn*den[b])
+                        SC_REPORT_ERROR(name(), "inconsistent SDF graph: the token rates do not balance");
+                }
+            }
+            // Scale the fractions to the smallest integer solution
+            long long l = 1, g = 0;
+            for (auto it=comp.begin();it!=comp.end();it++)
+                l = std::lcm(l, den[*it]);
+            for (auto it=comp.begin();it!=comp.end();it++)
+                g = std::gcd(g, num[*it] * (l/den[*it]));
+            for (auto it=comp.begin();it!=comp.end();it++)
+                reps[*it] = num[*it] * (l/den[*it]) / g;
+        }
+    }
+
+    //! Computes a periodic admissible sequential schedule
+    /*! The processes are fired symbolically starting from the initial
+     * tokens present in the signals, one firing per process in each
+     * round, until each process has fired as many times as required by
+     * the repetition vector.
+     */
+    void compute_schedule()
+    {
+        size_t n = actors.size();
+        std::vector<std::vector<size_t>> ins(n), outs(n);
+        std::vector<unsigned long> toks(edges.size());
+        for (size_t e=0; e<edges.size(); e++)
+        {
+            outs[edges[e].src].push_back(e);
+            ins[edges[e].dst].push_back(e);
+            toks[e] = edges[e].chan->direct_tokens();
+        }
+
+        unsigned long total = 0;
+        for (size_t a=0; a<n; a++) total += reps[a];
+
+        std::vector<unsigned long> fired(n, 0);
+        sched.clear();
+        while (sched.size() < total)
+        {
+            bool progress = false;
+            for (size_t a=0; a<n; a++)
+            {
+                if (fired[a] == reps[a]) continue;
+                bool ready = true;
+                for (auto it=ins[a].begin();it!=ins[a].end();it++)
+                    if (toks[*it] < edges[*it].cons) ready = false;
+                if (!ready) continue;
+                for (auto it=ins[a].begin();it!=ins[a].end();it++)
+                    toks[*it] -= edges[*it].cons;
+                for (auto it=outs[a].begin();it!=outs[a].end();it++)
+                    toks[*it] += edges[*it].prod;
+                fired[a]++;
+                sched.push_back(a);
+                progress = true;
+            }
+            if (!progress)
+                SC_REPORT_ERROR(name(), "the SDF graph deadlocks: not enough initial tokens in a cycle");
+        }
+    }
+};
+
+}
+}
+
+#endif
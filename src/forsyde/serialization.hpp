@@ -0,0 +1,350 @@
+/**********************************************************************
+    * serialization.hpp -- Serialization of tokens for transmission   *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Converting tokens of arbitrary types to and from byte  *
+    *          buffers which can be transmitted between processes     *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+/*! \file serialization.hpp
+ * \brief Implements the serialization of tokens used in parallel simulations
+ *
+ *  This file includes the serializer trait which is used by the sender
+ * and receiver processes of the parallel simulations to transmit tokens. It is specialized for the
+ * trivially copyable types, the standard containers, pairs, tuples,
+ * absent-extended values and time-tagged events. The users can
+ * specialize it for their own token types.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <deque>
+#include <list>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "abst_ext.hpp"
+#include "tt_event.hpp"
+
+namespace ForSyDe
+{
+
+//! The trait used to serialize tokens of type T
+/*! A specialization provides a pack function which appends the
+ * serialized token to a byte buffer and an unpack function which
+ * reconstructs a token from the buffer and advances the read pointer.
+ *
+ * The primary template has no definition, so that transmitting a type
+ * which has no serializer is reported at compile time.
+ */
+template <typename T, typename Enable=void>
+struct serializer;
+
+
+//! Can tokens of type T be transmitted as their raw bytes?
+template <typename T>
+struct is_bitwise_token : std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value && !std::is_same<T,bool>::value> {};
+
+//! The serializer of trivially copyable types copies their bytes
+template <typename T>
+struct serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+    static void pack(const T& val, std::vector<char>& buf)
+    {
+        const char* p = reinterpret_cast<const char*>(&val);
+        buf.insert(buf.end(), p, p+sizeof(T));
+    }
+    static void unpack(const char*& p, T& val)
+    {
+        std::memcpy(&val, p, sizeof(T));
+        p += sizeof(T);
+    }
+};
+
+//! Serializes a token by appending it to a buffer
+template <typename T>
+inline void pack(const T& val, std::vector<char>& buf)
+{
+    serializer<T>::pack(val, buf);
+}
+
+//! Deserializes a token from a buffer and advances the read pointer
+template <typename T>
+inline void unpack(const char*& p, T& val)
+{
+    serializer<T>::unpack(p, val);
+}
+
+//! Serializer of the sequential containers, as their size and elements
+template <typename C>
+struct sequence_serializer
+{
+    typedef typename C::value_type E;
+
+    static void pack(const C& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack((unsigned long long)val.size(), buf);
+        for (auto it=val.begin();it!=val.end();it++)
+            ForSyDe::pack(*it, buf);
+    }
+    static void unpack(const char*& p, C& val)
+    {
+        unsigned long long size;
+        ForSyDe::unpack(p, size);
+        val.clear();
+        for (unsigned long long i=0; i<size; i++)
+        {
+            E elem;
+            ForSyDe::unpack(p, elem);
+            val.push_back(std::move(elem));
+        }
+    }
+};
+
+//! Serializer of the contiguous containers of trivially copyable elements
+/*! The elements are copied with a single memcpy.
+ */
+template <typename C>
+struct contiguous_serializer
+{
+    typedef typename C::value_type E;
+
+    static void pack(const C& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack((unsigned long long)val.size(), buf);
+        const char* p = reinterpret_cast<const char*>(val.data());
+        buf.insert(buf.end(), p, p+val.size()*sizeof(E));
+    }
+    static void unpack(const char*& p, C& val)
+    {
+        unsigned long long size;
+        ForSyDe::unpack(p, size);
+        val.resize(size);
+        if (size > 0) std::memcpy(&val[0], p, size*sizeof(E));
+        p += size*sizeof(E);
+    }
+};
+
+template <typename T, typename A>
+struct serializer<std::vector<T,A>>
+    : std::conditional<is_bitwise_token<T>::value,
+                       contiguous_serializer<std::vector<T,A>>,
+                       sequence_serializer<std::vector<T,A>>>::type {};
+
+template <typename C, typename Tr, typename A>
+struct serializer<std::basic_string<C,Tr,A>>
+    : contiguous_serializer<std::basic_string<C,Tr,A>> {};
+
+template <typename T, typename A>
+struct serializer<std::deque<T,A>> : sequence_serializer<std::deque<T,A>> {};
+
+template <typename T, typename A>
+struct serializer<std::list<T,A>> : sequence_serializer<std::list<T,A>> {};
+
+//! Serializer of arrays which are not trivially copyable
+template <typename T, size_t N>
+struct serializer<std::array<T,N>,
+                  typename std::enable_if<!std::is_trivially_copyable<std::array<T,N>>::value>::type>
+{
+    static void pack(const std::array<T,N>& val, std::vector<char>& buf)
+    {
+        for (size_t i=0; i<N; i++) ForSyDe::pack(val[i], buf);
+    }
+    static void unpack(const char*& p, std::array<T,N>& val)
+    {
+        for (size_t i=0; i<N; i++) ForSyDe::unpack(p, val[i]);
+    }
+};
+
+//! Serializer of maps, as their size and key-value pairs
+template <typename K, typename V, typename Cmp, typename A>
+struct serializer<std::map<K,V,Cmp,A>>
+{
+    static void pack(const std::map<K,V,Cmp,A>& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack((unsigned long long)val.size(), buf);
+        for (auto it=val.begin();it!=val.end();it++)
+        {
+            ForSyDe::pack(it->first, buf);
+            ForSyDe::pack(it->second, buf);
+        }
+    }
+    static void unpack(const char*& p, std::map<K,V,Cmp,A>& val)
+    {
+        unsigned long long size;
+        ForSyDe::unpack(p, size);
+        val.clear();
+        for (unsigned long long i=0; i<size; i++)
+        {
+            K key;
+            V value;
+            ForSyDe::unpack(p, key);
+            ForSyDe::unpack(p, value);
+            val.emplace(std::move(key), std::move(value));
+        }
+    }
+};
+
+//! Serializer of pairs which are not trivially copyable
+template <typename T1, typename T2>
+struct serializer<std::pair<T1,T2>,
+                  typename std::enable_if<!std::is_trivially_copyable<std::pair<T1,T2>>::value>::type>
+{
+    static void pack(const std::pair<T1,T2>& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack(val.first, buf);
+        ForSyDe::pack(val.second, buf);
+    }
+    static void unpack(const char*& p, std::pair<T1,T2>& val)
+    {
+        ForSyDe::unpack(p, val.first);
+        ForSyDe::unpack(p, val.second);
+    }
+};
+
+//! Serializer of tuples which are not trivially copyable
+template <typename... Ts>
+struct serializer<std::tuple<Ts...>,
+                  typename std::enable_if<!std::is_trivially_copyable<std::tuple<Ts...>>::value>::type>
+{
+    static void pack(const std::tuple<Ts...>& val, std::vector<char>& buf)
+    {
+        std::apply([&buf](const Ts&... elems) {(ForSyDe::pack(elems, buf), ...);}, val);
+    }
+    static void unpack(const char*& p, std::tuple<Ts...>& val)
+    {
+        std::apply([&p](Ts&... elems) {(ForSyDe::unpack(p, elems), ...);}, val);
+    }
+};
+
+//! Serializer of absent-extended values which are not trivially copyable
+/*! The value is only serialized if it is present.
+ */
+template <typename T>
+struct serializer<abst_ext<T>,
+                  typename std::enable_if<!std::is_trivially_copyable<abst_ext<T>>::value>::type>
+{
+    static void pack(const abst_ext<T>& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack(val.is_present(), buf);
+        if (val.is_present())
+            ForSyDe::pack(val.unsafe_from_abst_ext(), buf);
+    }
+    static void unpack(const char*& p, abst_ext<T>& val)
+    {
+        bool present;
+        ForSyDe::unpack(p, present);
+        if (present)
+        {
+            T value;
+            ForSyDe::unpack(p, value);
+            val.set_val(value);
+        }
+        else
+            val.set_abst();
+    }
+};
+
+//! Serializer of time-tagged events, as their value and time tag
+template <typename VT>
+struct serializer<tt_event<VT,sc_core::sc_time>>
+{
+    static void pack(const tt_event<VT,sc_core::sc_time>& val, std::vector<char>& buf)
+    {
+        ForSyDe::pack(get_value(val), buf);
+        ForSyDe::pack(get_time(val).value(), buf);
+    }
+    static void unpack(const char*& p, tt_event<VT,sc_core::sc_time>& val)
+    {
+        VT value;
+        sc_dt::uint64 time;
+        ForSyDe::unpack(p, value);
+        ForSyDe::unpack(p, time);
+        set_value(val, value);
+        set_time(val, sc_core::sc_time::from_value(time));
+    }
+};
+
+//! Is there a serializer for tokens of type T?
+/*! The serializers of the containers, pairs, tuples, absent-extended
+ * values and events are only usable if their elements have serializers
+ * too, so the check recurses into the element types.
+ */
+//! Is the serializer trait specialized for T?
+template <typename T, typename Enable=void>
+struct has_serializer_specialization : std::false_type {};
+
+template <typename T>
+struct has_serializer_specialization<T, decltype((void)&serializer<T>::pack)> : std::true_type {};
+
+template <typename T>
+struct has_serializer : has_serializer_specialization<T> {};
+
+template <typename T, typename A>
+struct has_serializer<std::vector<T,A>> : has_serializer<T> {};
+
+template <typename T, typename A>
+struct has_serializer<std::deque<T,A>> : has_serializer<T> {};
+
+template <typename T, typename A>
+struct has_serializer<std::list<T,A>> : has_serializer<T> {};
+
+template <typename T, size_t N>
+struct has_serializer<std::array<T,N>> : has_serializer<T> {};
+
+template <typename K, typename V, typename Cmp, typename A>
+struct has_serializer<std::map<K,V,Cmp,A>>
+    : std::integral_constant<bool, has_serializer<K>::value && has_serializer<V>::value> {};
+
+template <typename T1, typename T2>
+struct has_serializer<std::pair<T1,T2>>
+    : std::integral_constant<bool, has_serializer<T1>::value && has_serializer<T2>::value> {};
+
+template <typename... Ts>
+struct has_serializer<std::tuple<Ts...>>
+    : std::integral_constant<bool, (has_serializer<Ts>::value && ...)> {};
+
+template <typename T>
+struct has_serializer<abst_ext<T>> : has_serializer<T> {};
+
+template <typename VT>
+struct has_serializer<tt_event<VT,sc_core::sc_time>> : has_serializer<VT> {};
+
+//! Serializes a sequence of tokens by appending them to a buffer
+template <typename T>
+inline void pack_tokens(const std::vector<T>& vals, std::vector<char>& buf)
+{
+    for (auto it=vals.begin();it!=vals.end();it++)
+        ForSyDe::pack(*it, buf);
+}
+
+//! Deserializes all tokens stored in size bytes into vals
+template <typename T>
+inline void unpack_tokens(const char* data, size_t size, std::vector<T>& vals)
+{
+    vals.clear();
+    const char* p = data;
+    while (p < data + size)
+    {
+        T val;
+        ForSyDe::unpack(p, val);
+        vals.push_back(std::move(val));
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,732 @@
+/**********************************************************************
+    * shm_sim.hpp -- Primitives used for shared-memory parallel       *
+    *                simulation                                       *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing primitive elements required for simulating   *
+    *          ForSyDe models in several processes of one machine     *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SHM_SIM_HPP
+#define SHM_SIM_HPP
+
+/*! \file shm_sim.hpp
+ * \brief Definition of shared-memory sender and receiver processes
+ *
+ *  This file includes the process constructors and other facilities
+ * used for parallel simulations whose sub-simulations run as separate
+ * processes of the same (Linux) machine, without requiring MPI.
+ *
+ * The sub-simulations are forked from the main function using
+ * shm_launch(). A shm_sender and a shm_receiver with the same channel
+ * name are connected through a ring buffer in a POSIX shared memory
+ * segment. Like the MPI senders, a shared-memory sender packs up to
+ * batch tokens into each message and sends a partial batch when its
+ * input stays empty for lookahead delta cycles.
+ *
+ * A sender or receiver which cannot proceed yields to the other
+ * processes of its sub-simulation as long as they have activity in the
+ * current time. When its sub-simulation has nothing else to do, one of
+ * the blocked senders and receivers sleeps on a futex until a peer
+ * updates its ring buffer, instead of spinning in delta cycles, and the
+ * others wait for it to wake up. If the peer sub-simulation exits, the
+ * simulation is stopped.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "serialization.hpp"
+
+namespace ForSyDe
+{
+
+using namespace sc_core;
+
+//! The index of the current sub-simulation started by shm_launch(), or -1
+inline int& shm_subsim_id()
+{
+    static int id = -1;
+    return id;
+}
+
+//! The prefix of the names of the shared memory segments of the current run
+inline std::string shm_session()
+{
+    const char* s = std::getenv("FORSYDE_SHM_SESSION");
+    return s != NULL ? s : "forsyde";
+}
+
+//! Runs n sub-simulations in forked processes and waits for them
+/*! The function subsim is called in each child process with the index
+ * of its sub-simulation, and should construct the model and run it.
+ * Since a SystemC model can be elaborated only once per process, this
+ * function should be called from sc_main before any module is created.
+ *
+ * The shared memory segments of the run are removed when all of the
+ * sub-simulations have finished. Returns the number of sub-simulations
+ * which failed.
+ */
+inline int shm_launch(int n, const std::function<void(int)>& subsim)
+{
+    std::string session = "forsyde." + std::to_string(getpid());
+    setenv("FORSYDE_SHM_SESSION", session.c_str(), 1);
+    std::vector<pid_t> pids;
+    for (int i=0; i<n; i++)
+    {
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            shm_subsim_id() = i;
+            subsim(i);
+            std::cout.flush();
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    int failed = 0;
+    for (auto it=pids.begin();it!=pids.end();it++)
+    {
+        int status = -1;
+        if (*it > 0) waitpid(*it, &status, 0);
+        if (*it < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            failed++;
+    }
+
+    std::string prefix = session + ".";
+    if (DIR* dir = opendir("/dev/shm"))
+    {
+        while (struct dirent* ent = readdir(dir))
+            if (std::strncmp(ent->d_name, prefix.c_str(), prefix.size()) == 0)
+                shm_unlink(("/" + std::string(ent->d_name)).c_str());
+        closedir(dir);
+    }
+    return failed;
+}
+
+//! A ring buffer of messages in a shared memory segment
+/*! The ring buffer connects a single writer and a single reader, which
+ * may live in different processes. Each message is stored as its size
+ * followed by its bytes. The positions of the writer (head) and the
+ * reader (tail) grow monotonically and are reduced modulo the capacity,
+ * which is a power of two.
+ *
+ * The blocking operations should be called from SystemC threads.
+ */
+class shm_channel
+{
+public:
+    shm_channel() : hdr(NULL), buf(NULL), cap(0) {}
+
+    ~shm_channel()
+    {
+        close();
+    }
+
+    //! Maps the segment of a channel, creating it if needed
+    void open(const std::string& name,  ///< name of the channel
+              uint32_t capacity,        ///< capacity in bytes (a power of two)
+              bool writer               ///< is the caller the writer?
+             )
+    {
+        if (capacity == 0 || (capacity & (capacity-1)) != 0)
+            SC_REPORT_ERROR(name.c_str(), "the capacity of a shared memory channel should be a power of two");
+        seg_name = "/" + shm_session() + "." + name;
+        int fd = shm_open(seg_name.c_str(), O_CREAT|O_RDWR, 0600);
+        if (fd < 0)
+            SC_REPORT_ERROR(name.c_str(), "cannot open the shared memory segment");
+        size_t size = sizeof(header) + capacity;
+        struct stat st;
+        if (fstat(fd, &st) != 0 ||
+            ((size_t)st.st_size < size && ftruncate(fd, size) != 0))
+            SC_REPORT_ERROR(name.c_str(), "cannot resize the shared memory segment");
+        void* mem = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+            SC_REPORT_ERROR(name.c_str(), "cannot map the shared memory segment");
+        // A new segment is filled with zeros, which is an empty ring buffer
+        hdr = static_cast<header*>(mem);
+        buf = static_cast<char*>(mem) + sizeof(header);
+        cap = capacity;
+        uint32_t other = 0;
+        if (!hdr->capacity.compare_exchange_strong(other, capacity) && other != capacity)
+            SC_REPORT_ERROR(name.c_str(), "the two ends of a shared memory channel have different capacities");
+        (writer ? hdr->writer_pid : hdr->reader_pid).store(getpid());
+    }
+
+    //! Unmaps the segment
+    void close()
+    {
+        if (hdr == NULL) return;
+        munmap(hdr, sizeof(header) + cap);
+        hdr = NULL;
+    }
+
+    //! Removes the segment, which remains mapped by the processes using it
+    void unlink()
+    {
+        shm_unlink(seg_name.c_str());
+    }
+
+    //! Writes a message, blocking while there is not enough space
+    void write_message(const char* data, uint32_t size)
+    {
+        if (sizeof(uint32_t) + size > cap)
+            SC_REPORT_ERROR(seg_name.c_str(), "message larger than the shared memory channel");
+        uint32_t head = hdr->head.load(std::memory_order_relaxed);
+        uint32_t tail;
+        while (cap - (head - (tail = hdr->tail.load(std::memory_order_acquire)))
+               < sizeof(uint32_t) + size)
+            block_on(hdr->tail, tail, hdr->writer_waiting, hdr->reader_pid);
+        copy_in(head, reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+        copy_in(head + sizeof(uint32_t), data, size);
+        hdr->head.store(head + sizeof(uint32_t) + size, std::memory_order_seq_cst);
+        if (hdr->reader_waiting.load(std::memory_order_seq_cst))
+            futex(&hdr->head, FUTEX_WAKE, INT_MAX);
+    }
+
+    //! Reads a message into msg, blocking while the ring buffer is empty
+    void read_message(std::vector<char>& msg)
+    {
+        uint32_t tail = hdr->tail.load(std::memory_order_relaxed);
+        uint32_t head;
+        while ((head = hdr->head.load(std::memory_order_acquire)) == tail)
+            block_on(hdr->head, head, hdr->reader_waiting, hdr->writer_pid);
+        uint32_t size;
+        copy_out(tail, reinterpret_cast<char*>(&size), sizeof(uint32_t));
+        msg.resize(size);
+        copy_out(tail + sizeof(uint32_t), msg.data(), size);
+        hdr->tail.store(tail + sizeof(uint32_t) + size, std::memory_order_seq_cst);
+        if (hdr->writer_waiting.load(std::memory_order_seq_cst))
+            futex(&hdr->tail, FUTEX_WAKE, INT_MAX);
+    }
+
+private:
+    //! The control block at the beginning of the segment
+    /*! The positions are kept in separate cache lines to avoid false
+     * sharing between the writer and the reader.
+     */
+    struct header
+    {
+        alignas(64) std::atomic<uint32_t> head;
+        alignas(64) std::atomic<uint32_t> tail;
+        alignas(64) std::atomic<uint32_t> reader_waiting;
+        std::atomic<uint32_t> writer_waiting;
+        std::atomic<uint32_t> capacity;
+        std::atomic<int32_t> reader_pid;
+        std::atomic<int32_t> writer_pid;
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "shared memory channels require lock-free atomics");
+
+    header* hdr;
+    char* buf;
+    uint32_t cap;
+    std::string seg_name;
+
+    static long futex(std::atomic<uint32_t>* addr, int op, uint32_t val,
+                      const struct timespec* timeout=NULL)
+    {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), op, val,
+                       timeout, NULL, 0);
+    }
+
+    //! An endpoint blocked on a word of its channel
+    struct blocked_endpoint
+    {
+        shm_channel* chan;
+        std::atomic<uint32_t>* word;
+        uint32_t seen;
+        std::atomic<uint32_t>* waiting;
+        std::atomic<int32_t>* peer;
+    };
+
+    //! The blocked endpoints of the sub-simulation
+    /*! The first of them sleeps on behalf of all, while the others wait
+     * for it to notify them, so that they cause no activity.
+     */
+    struct blocked_set
+    {
+        std::vector<blocked_endpoint*> endpoints;
+        bool sleeping = false;
+        sc_event woken;
+
+        //! The single instance of a sub-simulation
+        static blocked_set& get()
+        {
+            // never destroyed, since the event outlives the simulation context
+            static blocked_set* set = new blocked_set;
+            return *set;
+        }
+
+        //! Has the word of any endpoint changed?
+        bool changed() const
+        {
+            for (auto it=endpoints.begin();it!=endpoints.end();it++)
+                if ((*it)->word->load(std::memory_order_seq_cst) != (*it)->seen)
+                    return true;
+            return false;
+        }
+    };
+
+    //! Waits until word differs from seen
+    /*! The simulation proceeds with the other processes while they have
+     * activity in the current time, otherwise the whole process sleeps
+     * until the peer changes the word.
+     */
+    void block_on(std::atomic<uint32_t>& word, uint32_t seen,
+                  std::atomic<uint32_t>& waiting, std::atomic<int32_t>& peer)
+    {
+        blocked_endpoint self = {this, &word, seen, &waiting, &peer};
+        blocked_set& set = blocked_set::get();
+        set.endpoints.push_back(&self);
+        if (set.sleeping)
+            wait(set.woken);
+        else
+        {
+            set.sleeping = true;
+            while (sc_pending_activity_at_current_time() && !set.changed())
+                wait(SC_ZERO_TIME);
+            while (!set.changed())
+                sleep(set, self);
+            set.sleeping = false;
+            set.woken.notify(SC_ZERO_TIME);
+        }
+        set.endpoints.erase(std::find(set.endpoints.begin(), set.endpoints.end(), &self));
+    }
+
+    //! Sleeps until the word of self changes or a timeout expires
+    /*! All blocked endpoints announce that they are waiting, but only the
+     * word of self can be waited for, so the timeout is short when others
+     * are blocked too. After the sleep, the peers of the endpoints are
+     * checked to be still alive.
+     */
+    static void sleep(blocked_set& set, blocked_endpoint& self)
+    {
+        for (auto it=set.endpoints.begin();it!=set.endpoints.end();it++)
+            (*it)->waiting->store(1, std::memory_order_seq_cst);
+        if (!set.changed())
+        {
+            struct timespec timeout = {0, set.endpoints.size() > 1 ? 1000000 : 100000000};
+            futex(self.word, FUTEX_WAIT, self.seen, &timeout);
+        }
+        for (auto it=set.endpoints.begin();it!=set.endpoints.end();it++)
+            (*it)->waiting->store(0, std::memory_order_relaxed);
+        if (set.changed()) return;
+        for (auto it=set.endpoints.begin();it!=set.endpoints.end();it++)
+        {
+            int32_t pid = (*it)->peer->load();
+            if (pid != 0 && kill(pid, 0) != 0 && errno == ESRCH)
+            {
+                SC_REPORT_WARNING((*it)->chan->seg_name.c_str(), "the peer sub-simulation has exited");
+                sc_stop();
+                wait();
+            }
+        }
+    }
+
+    void copy_in(uint32_t pos, const char* src, uint32_t n)
+    {
+        uint32_t off = pos & (cap-1);
+        uint32_t first = std::min(n, cap - off);
+        std::memcpy(buf + off, src, first);
+        std::memcpy(buf, src + first, n - first);
+    }
+
+    void copy_out(uint32_t pos, char* dst, uint32_t n)
+    {
+        uint32_t off = pos & (cap-1);
+        uint32_t first = std::min(n, cap - off);
+        std::memcpy(dst, buf + off, first);
+        std::memcpy(dst + first, buf, n - first);
+    }
+};
+
+namespace SY
+{
+
+using namespace sc_core;
+
+
+//! Process constructor for a shared-memory sender process with one input
+/*! This class is used to build a processes with one input. It transmits
+ * the non-absent events it receives to the shm_receiver with the same
+ * channel name in another sub-simulation. Up to batch tokens are packed
+ * into each message.
+ */
+template <typename T1>
+class shm_sender : public sy_process
+{
+public:
+    SY_in<T1>  iport1;       ///< port for the input channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from its input port and
+     * writes them to the shared memory channel.
+     */
+    shm_sender(sc_module_name _name,     ///< process name
+               const std::string& channel,  ///< name of the shared memory channel
+               unsigned batch=1,         ///< maximum number of tokens per message
+               unsigned lookahead=0,     ///< delta cycles to wait for more tokens
+               uint32_t capacity=1<<20   ///< capacity of the channel in bytes
+             ) : sy_process(_name), iport1("iport1"),
+                 channel(channel), batch(batch), lookahead(lookahead),
+                 capacity(capacity)
+    {
+        if (batch == 0)
+            SC_REPORT_ERROR(name(), "the batch size should be at least one");
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("channel",channel));
+        arg_vec.push_back(std::make_tuple("batch",std::to_string(batch)));
+        arg_vec.push_back(std::make_tuple("lookahead",std::to_string(lookahead)));
+        arg_vec.push_back(std::make_tuple("capacity",std::to_string(capacity)));
+#endif
+    }
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "SY::shm_sender";}
+
+private:
+    std::string channel;
+    unsigned batch;
+    unsigned lookahead;
+    uint32_t capacity;
+    shm_channel ring;
+
+    // Inputs and output variables
+    std::vector<T1>* ivals;
+    std::vector<char> buf;      ///< serialized tokens of a message
+
+    //Implementing the abstract semantics
+    void init()
+    {
+        ivals = new std::vector<T1>;
+        ivals->reserve(batch);
+        ring.open(channel, capacity, true);
+    }
+
+    void prep()
+    {
+        abst_ext<T1> temp_val = iport1.read();
+        ivals->push_back(unsafe_from_abst_ext(temp_val));
+    }
+
+    void exec() {}
+
+    void prod()
+    {
+        if (ivals->size() < batch)
+        {
+            for (unsigned i=0; i<lookahead && iport1.num_available()==0; i++)
+                wait(SC_ZERO_TIME);
+            if (iport1.num_available() > 0) return;
+        }
+        buf.clear();
+        pack_tokens(*ivals, buf);
+        ring.write_message(buf.data(), buf.size());
+        ivals->clear();
+    }
+
+    void clean()
+    {
+        delete ivals;
+    }
+
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundInChans.resize(1);     // only one input port
+        boundInChans[0].port = &iport1;
+    }
+#endif
+};
+
+//! Process constructor for a shared-memory receiver process with one output
+/*! This class is used to build a processes with one output. It receives
+ * the events sent by the shm_sender with the same channel name in
+ * another sub-simulation and writes them to its output signal.
+ */
+template <typename T0>
+class shm_receiver : public sy_process
+{
+public:
+    SY_out<T0>  oport1;       ///< port for the output channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from the shared memory
+     * channel and writes them using the output port.
+     */
+    shm_receiver(sc_module_name _name,     ///< process name
+                 const std::string& channel,  ///< name of the shared memory channel
+                 uint32_t capacity=1<<20   ///< capacity of the channel in bytes
+               ) : sy_process(_name), oport1("oport1"),
+                   channel(channel), capacity(capacity)
+    {
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("channel",channel));
+        arg_vec.push_back(std::make_tuple("capacity",std::to_string(capacity)));
+#endif
+    }
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "SY::shm_receiver";}
+
+private:
+    std::string channel;
+    uint32_t capacity;
+    shm_channel ring;
+
+    // Inputs and output variables
+    std::vector<char> buf;      ///< serialized tokens of a message
+    std::vector<T0>* msg;
+    std::vector<abst_ext<T0>>* ovals;
+
+    //Implementing the abstract semantics
+    void init()
+    {
+        msg = new std::vector<T0>;
+        ovals = new std::vector<abst_ext<T0>>;
+        ring.open(channel, capacity, false);
+    }
+
+    void prep()
+    {
+        ring.read_message(buf);
+        unpack_tokens(buf.data(), buf.size(), *msg);
+    }
+
+    void exec()
+    {
+        ovals->resize(msg->size());
+        for (size_t i=0; i<msg->size(); i++)
+            set_val((*ovals)[i], (*msg)[i]);
+    }
+
+    void prod()
+    {
+        oport1.write_n(*ovals);
+    }
+
+    void clean()
+    {
+        ring.unlink();
+        delete msg;
+        delete ovals;
+    }
+
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundOutChans.resize(1);    // only one output port
+        boundOutChans[0].port = &oport1;
+    }
+#endif
+};
+
+
+}
+
+namespace SDF
+{
+
+using namespace sc_core;
+
+
+//! Process constructor for a shared-memory sender process with one input
+/*! This class is used to build a processes with one input. It transmits
+ * the tokens it receives to the shm_receiver with the same channel name
+ * in another sub-simulation. Up to batch tokens are packed into each
+ * message.
+ */
+template <typename T1>
+class shm_sender : public sdf_process
+{
+public:
+    SDF_in<T1>  iport1;       ///< port for the input channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from its input port and
+     * writes them to the shared memory channel.
+     */
+    shm_sender(sc_module_name _name,     ///< process name
+               const std::string& channel,  ///< name of the shared memory channel
+               unsigned batch=1,         ///< maximum number of tokens per message
+               unsigned lookahead=0,     ///< delta cycles to wait for more tokens
+               uint32_t capacity=1<<20   ///< capacity of the channel in bytes
+             ) : sdf_process(_name), iport1("iport1"),
+                 channel(channel), batch(batch), lookahead(lookahead),
+                 capacity(capacity)
+    {
+        if (batch == 0)
+            SC_REPORT_ERROR(name(), "the batch size should be at least one");
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("channel",channel));
+        arg_vec.push_back(std::make_tuple("batch",std::to_string(batch)));
+        arg_vec.push_back(std::make_tuple("lookahead",std::to_string(lookahead)));
+        arg_vec.push_back(std::make_tuple("capacity",std::to_string(capacity)));
+#endif
+    }
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "SDF::shm_sender";}
+
+private:
+    std::string channel;
+    unsigned batch;
+    unsigned lookahead;
+    uint32_t capacity;
+    shm_channel ring;
+
+    // Inputs and output variables
+    std::vector<T1>* ivals;
+    std::vector<char> buf;      ///< serialized tokens of a message
+
+    //Implementing the abstract semantics
+    void init()
+    {
+        ivals = new std::vector<T1>;
+        ivals->reserve(batch);
+        ring.open(channel, capacity, true);
+    }
+
+    void prep()
+    {
+        ivals->push_back(iport1.read());
+    }
+
+    void exec() {}
+
+    void prod()
+    {
+        if (ivals->size() < batch)
+        {
+            for (unsigned i=0; i<lookahead && iport1.num_available()==0; i++)
+                wait(SC_ZERO_TIME);
+            if (iport1.num_available() > 0) return;
+        }
+        buf.clear();
+        pack_tokens(*ivals, buf);
+        ring.write_message(buf.data(), buf.size());
+        ivals->clear();
+    }
+
+    void clean()
+    {
+        delete ivals;
+    }
+
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundInChans.resize(1);     // only one input port
+        boundInChans[0].port = &iport1;
+    }
+#endif
+};
+
+//! Process constructor for a shared-memory receiver process with one output
+/*! This class is used to build a processes with one output. It receives
+ * the tokens sent by the shm_sender with the same channel name in
+ * another sub-simulation and writes them to its output signal.
+ */
+template <typename T0>
+class shm_receiver : public sdf_process
+{
+public:
+    SDF_out<T0>  oport1;       ///< port for the output channel
+
+    //! The constructor requires the module name
+    /*! It creates an SC_THREAD which reads data from the shared memory
+     * channel and writes them using the output port.
+     */
+    shm_receiver(sc_module_name _name,     ///< process name
+                 const std::string& channel,  ///< name of the shared memory channel
+                 uint32_t capacity=1<<20   ///< capacity of the channel in bytes
+               ) : sdf_process(_name), oport1("oport1"),
+                   channel(channel), capacity(capacity)
+    {
+#ifdef FORSYDE_INTROSPECTION
+        arg_vec.push_back(std::make_tuple("channel",channel));
+        arg_vec.push_back(std::make_tuple("capacity",std::to_string(capacity)));
+#endif
+    }
+
+    //! Specifying from which process constructor is the module built
+    std::string forsyde_kind() const {return "SDF::shm_receiver";}
+
+private:
+    std::string channel;
+    uint32_t capacity;
+    shm_channel ring;
+
+    // Inputs and output variables
+    std::vector<char> buf;      ///< serialized tokens of a message
+    std::vector<T0>* ovals;
+
+    //Implementing the abstract semantics
+    void init()
+    {
+        ovals = new std::vector<T0>;
+        ring.open(channel, capacity, false);
+    }
+
+    void prep()
+    {
+        ring.read_message(buf);
+        unpack_tokens(buf.data(), buf.size(), *ovals);
+    }
+
+    void exec() {}
+
+    void prod()
+    {
+        oport1.write_n(*ovals);
+    }
+
+    void clean()
+    {
+        ring.unlink();
+        delete ovals;
+    }
+
+#ifdef FORSYDE_INTROSPECTION
+    void bindInfo()
+    {
+        boundOutChans.resize(1);    // only one output port
+        boundOutChans[0].port = &oport1;
+    }
+#endif
+};
+
+
+}
+
+}
+
+#endif
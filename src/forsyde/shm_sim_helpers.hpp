@@ -0,0 +1,137 @@
+/**********************************************************************
+    * shm_sim_helpers.hpp -- Helper primitives for shared-memory      *
+    *                        parallel simulation                      *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing helper primitives for shared-memory parallel *
+    *          simulations                                            *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SHM_SIM_HELPERS_HPP
+#define SHM_SIM_HELPERS_HPP
+
+/*! \file shm_sim_helpers.hpp
+ * \brief Implements helper primitives for shared-memory parallel simulations
+ * 
+ *  This file includes helper functions which facilliate construction of
+ * sub-simulations connected through shared memory.
+ */
+
+#include "shm_sim.hpp"
+
+
+namespace ForSyDe
+{
+
+namespace SY
+{
+
+using namespace sc_core;
+
+//! Helper function to construct a shared-memory sender process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its input signal.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the input FIFOs.
+ */
+template <class T0, template <class> class I0If>
+inline shm_sender<T0>* make_shm_sender(const std::string& pName,
+    const std::string& channel,   ///< name of the shared memory channel
+    I0If<T0>& inp1S,
+    unsigned batch=1,             ///< maximum number of tokens per message
+    unsigned lookahead=0,         ///< delta cycles to wait for more tokens
+    uint32_t capacity=1<<20       ///< capacity of the channel in bytes
+    )
+{
+    auto p = new shm_sender<T0>(pName.c_str(), channel, batch, lookahead, capacity);
+    
+    (*p).iport1(inp1S);
+    
+    return p;
+}
+
+//! Helper function to construct a shared-memory receiver process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its output signal.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the output FIFOs.
+ */
+template <class T0, template <class> class OIf>
+inline shm_receiver<T0>* make_shm_receiver(const std::string& pName,
+    const std::string& channel,   ///< name of the shared memory channel
+    OIf<T0>& outS,
+    uint32_t capacity=1<<20       ///< capacity of the channel in bytes
+    )
+{
+    auto p = new shm_receiver<T0>(pName.c_str(), channel, capacity);
+    
+    (*p).oport1(outS);
+    
+    return p;
+}
+
+
+}
+
+namespace SDF
+{
+
+using namespace sc_core;
+
+//! Helper function to construct a shared-memory sender process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its input signal.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the input FIFOs.
+ */
+template <class T0, template <class> class I0If>
+inline shm_sender<T0>* make_shm_sender(const std::string& pName,
+    const std::string& channel,   ///< name of the shared memory channel
+    I0If<T0>& inp1S,
+    unsigned batch=1,             ///< maximum number of tokens per message
+    unsigned lookahead=0,         ///< delta cycles to wait for more tokens
+    uint32_t capacity=1<<20       ///< capacity of the channel in bytes
+    )
+{
+    auto p = new shm_sender<T0>(pName.c_str(), channel, batch, lookahead, capacity);
+    
+    (*p).iport1(inp1S);
+    
+    return p;
+}
+
+//! Helper function to construct a shared-memory receiver process
+/*! This function is used to construct a process (SystemC module) and
+ * connect its output signal.
+ * It provides a more functional style definition of a ForSyDe process.
+ * It also removes bilerplate code by using type-inference feature of
+ * C++ and automatic binding to the output FIFOs.
+ */
+template <class T0, template <class> class OIf>
+inline shm_receiver<T0>* make_shm_receiver(const std::string& pName,
+    const std::string& channel,   ///< name of the shared memory channel
+    OIf<T0>& outS,
+    uint32_t capacity=1<<20       ///< capacity of the channel in bytes
+    )
+{
+    auto p = new shm_receiver<T0>(pName.c_str(), channel, capacity);
+    
+    (*p).oport1(outS);
+    
+    return p;
+}
+
+
+}
+
+}
+
+#endif
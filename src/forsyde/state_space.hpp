@@ -0,0 +1,559 @@
+/**********************************************************************
+    * state_space.hpp -- State-space models of linear filters         *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Converting transfer functions to state-space models    *
+    *          and integrating them                                   *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef STATE_SPACE_HPP
+#define STATE_SPACE_HPP
+
+/*! \file state_space.hpp
+ * \brief Implements the state-space models used by the linear filters
+ *
+ *  This file includes the kernels which integrate the single-input
+ * single-output state-space model of a transfer function for the linear
+ * filters, together with a controller for the step sizes of the adaptive
+ * filters. The kernels of low-order filters keep the model and the
+ * states in fixed-size arrays, so integrating them does not allocate
+ * any memory. With ct_vector coefficients and values, a kernel
+ * integrates a bank of filters of the same order in lockstep.
+ */
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "ct_vector.hpp"
+
+//! The highest filter order integrated with the fixed-size kernels
+#ifndef FORSYDE_FIXED_FILTER_ORDER
+#define FORSYDE_FIXED_FILTER_ORDER 16
+#endif
+
+namespace ForSyDe
+{
+
+//! The magnitude of a scalar value, used in the error estimations
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+norm_inf(const T& v)
+{
+    return std::abs(v);
+}
+
+//! Access to the lanes of the coefficients and values of the kernels
+/*! A ct_vector holds one lane per filter of a bank, while a scalar is
+ * a single lane shared by all filters.
+ */
+template <typename T>
+struct ss_lanes
+{
+    typedef T value_type;
+    static constexpr std::size_t size = 1;
+    static T& at(T& v, std::size_t) {return v;}
+};
+
+template <typename T, std::size_t N>
+struct ss_lanes<ct_vector<T,N>>
+{
+    typedef T value_type;
+    static constexpr std::size_t size = N;
+    static T& at(ct_vector<T,N>& v, std::size_t i) {return v[i];}
+};
+
+//! The solvers used to integrate the linear filters
+/*! - RK4 is the classical Runge-Kutta method. The adaptive filters
+ *    estimate its error by comparing a step with two half steps.
+ *  - DOPRI5 is the Dormand-Prince 5(4) method with an embedded error
+ *    estimate, suited for non-stiff filters.
+ *  - ROSENBROCK is the L-stable ROS2 Rosenbrock method, which takes
+ *    large steps on stiff filters.
+ */
+enum filter_solver {RK4, DOPRI5, ROSENBROCK};
+
+//! The instants at which a solver evaluates the input in a step
+/*! They are given as fractions of the step. The DDE filters sample
+ * their inputs at these instants.
+ */
+inline const std::vector<double>& solver_nodes(filter_solver solver)
+{
+    static const std::vector<double> rk4 = {0, 0.5, 1};
+    static const std::vector<double> dopri5 = {0, 0.2, 0.3, 0.8, 8.0/9, 1};
+    static const std::vector<double> rosenbrock = {0, 1};
+    return solver == DOPRI5 ? dopri5 : solver == ROSENBROCK ? rosenbrock : rk4;
+}
+
+//! The input at the fraction th of a step over which it changes linearly from u0 to u1
+/*! The midpoint is computed as (u0 + u1)*0.5, like in the original
+ * Runge-Kutta solver of the filters, so that their RK4 steps are
+ * reproduced exactly.
+ */
+template <typename T>
+inline T linear_input(const T& u0, const T& u1, double th)
+{
+    if (th == 0) return u0;
+    if (th == 1) return u1;
+    if (th == 0.5) return (u0 + u1)*0.5;
+    return u0 + th*(u1 - u0);
+}
+
+//! The order of the error estimated by a solver per unit of time
+inline unsigned solver_error_order(filter_solver solver)
+{
+    return solver == ROSENBROCK ? 1 : 4;
+}
+
+//! A PI controller of the step sizes of the adaptive filters
+/*! It scales a step according to the ratio of its estimated error to
+ * the tolerance, and to that of the previous accepted step, which
+ * damps the oscillations of the step sizes.
+ */
+class step_control
+{
+public:
+    //! The controller of a solver with errors of the given order
+    step_control(unsigned order=4)
+        : alpha(1.0/order - 0.75*beta), err_prev(1) {}
+
+    //! The factor for the next step after a step with the relative error err
+    double factor(double err, bool accepted)
+    {
+        double fac = max_fac;
+        if (err > 0)
+            fac = safety*std::pow(err, -alpha)*(accepted ? std::pow(err_prev, beta) : 1);
+        fac = std::min(std::max(fac, min_fac), accepted ? max_fac : 1.0);
+        if (accepted) err_prev = std::max(err, 1e-4);
+        return fac;
+    }
+
+private:
+    static constexpr double beta = 0.04, safety = 0.9, min_fac = 0.2, max_fac = 5;
+    double alpha, err_prev;
+};
+
+//! The interface of the state-space kernels
+/*! A kernel holds the model of a filter in the controllable canonical
+ * form, and four slots for its states which the filters use for the
+ * committed state and the candidate states of a step.
+ *
+ * The coefficients are of type C, while the states, inputs and outputs
+ * are of a value type T which can also be a ct_vector, in which case
+ * each of its elements is filtered independently. If C is a ct_vector
+ * too, each element has its own coefficients, and the states are laid
+ * out as a structure of arrays whose lanes are updated together.
+ */
+template <typename T, typename C=T>
+class ss_kernel
+{
+public:
+    //! The input over a step, as a function of the fraction of the step
+    typedef std::function<T(double)> input_type;
+
+    //! The number of state slots
+    static constexpr unsigned slots = 4;
+
+    virtual ~ss_kernel() {}
+
+    //! The number of states
+    virtual unsigned order() const = 0;
+
+    //! The direct feed-through coefficient D
+    virtual C feedthrough() const = 0;
+
+    //! Sets the states of all slots to zero
+    virtual void reset() = 0;
+
+    //! Copies the states of slot src to slot dst
+    virtual void copy(unsigned dst, unsigned src) = 0;
+
+    //! Computes C x, the output of slot src without the feed-through
+    virtual T state_output(unsigned src) const = 0;
+
+    //! Computes the output C x + D u of the states in slot src
+    virtual T output(unsigned src, const T& u) const = 0;
+
+    //! Computes C (A x + B u), the derivative of the state output of slot src
+    virtual T state_output_deriv(unsigned src, const T& u) const = 0;
+
+    //! Integrates the states of slot src over a step h into slot dst
+    /*! If err is not NULL, it also estimates the error of the output per
+     * unit of time. It returns the output at the end of the step.
+     */
+    virtual T step(unsigned dst, unsigned src, double h,
+                   const input_type& u, double* err) = 0;
+};
+
+//! A state-space kernel of order N
+/*! The model, the states and the scratch vectors of the solvers are
+ * kept in aligned, compile-time-sized arrays. The loops have constant
+ * bounds, so they are unrolled and vectorized, and the stages are
+ * computed in place without temporaries. For N equal to 0 the order is
+ * given at run time and the arrays are allocated once on construction.
+ */
+template <typename T, typename C, unsigned N>
+class basic_ss_kernel : public ss_kernel<T,C>
+{
+public:
+    typedef typename ss_kernel<T,C>::input_type input_type;
+
+    //! The kernel of the transfer function num/den, using the given solver
+    basic_ss_kernel(const std::vector<C>& num, const std::vector<C>& den,
+                    filter_solver solver)
+        : states(den.size()-1), solver(solver), lu_h(0)
+    {
+        const unsigned n = dim();
+        resize(a, n*n); resize(b, n); resize(c, n); resize(lu, n*n);
+        resize(perm, n); resize(xt, n); resize(xf, n); resize(xh, n);
+        for (auto& v : xs) resize(v, n);
+        for (auto& v : k) resize(v, n);
+        // Pad and normalize w.r.t the leading coefficient of the denominator
+        const unsigned nn = num.size();
+        std::vector<C> nm(n+1, C());
+        for (unsigned i=0; i<nn; i++) nm[n+1-nn+i] = num[i]/den[0];
+        for (unsigned i=0; i<n*n; i++) a[i] = C();
+        // The super-diagonal is set to '1'
+        for (unsigned i=0; i+1<n; i++) a[i*n+i+1] = C(1);
+        // The lower row and the output coefficients
+        for (unsigned j=0; j<n; j++)
+        {
+            C dj = den[j+1]/den[0];
+            a[(n-1)*n+n-1-j] = -dj;
+            c[n-1-j] = nm[j+1] - nm[0]*dj;
+            b[j] = C();
+        }
+        if (n) b[n-1] = C(1);
+        d = nm[0];
+        reset();
+    }
+
+    unsigned order() const {return dim();}
+
+    C feedthrough() const {return d;}
+
+    void reset()
+    {
+        const unsigned n = dim();
+        for (auto& x : xs)
+            for (unsigned i=0; i<n; i++) x[i] = T();
+    }
+
+    void copy(unsigned dst, unsigned src)
+    {
+        const unsigned n = dim();
+        for (unsigned i=0; i<n; i++) xs[dst][i] = xs[src][i];
+    }
+
+    T state_output(unsigned src) const
+    {
+        return project(&xs[src][0]);
+    }
+
+    T output(unsigned src, const T& u) const
+    {
+        // The feed-through is added first, like in the original solver
+        const unsigned n = dim();
+        T y = d*u;
+        for (unsigned j=0; j<n; j++) y += c[j]*xs[src][j];
+        return y;
+    }
+
+    T state_output_deriv(unsigned src, const T& u) const
+    {
+        const unsigned n = dim();
+        T y = T();
+        for (unsigned i=0; i<n; i++)
+        {
+            T s = b[i]*u;
+            for (unsigned j=0; j<n; j++) s += a[i*n+j]*xs[src][j];
+            y += c[i]*s;
+        }
+        return y;
+    }
+
+    T step(unsigned dst, unsigned src, double h, const input_type& u, double* err)
+    {
+        const unsigned n = dim();
+        T* xn = &xs[dst][0];
+        const T* x = &xs[src][0];
+        switch (solver)
+        {
+        case DOPRI5:
+            dopri5(xn, x, h, u, err);
+            break;
+        case ROSENBROCK:
+            rosenbrock(xn, x, h, u, err);
+            break;
+        default:
+            if (err)
+            {
+                // Compares a full step with two half steps
+                rk4(&xf[0], x, h, u, 0, 1);
+                rk4(&xh[0], x, h/2, u, 0, 0.5);
+                rk4(xn, &xh[0], h/2, u, 0.5, 0.5);
+                for (unsigned i=0; i<n; i++) xf[i] = xn[i] - xf[i];
+                *err = (double)norm_inf(project(&xf[0]))/h;
+            }
+            else
+                rk4(xn, x, h, u, 0, 1);
+        }
+        return this->output(dst, u(1));
+    }
+
+private:
+    // The storage of the vectors and matrices
+    template <typename V>
+    using array = typename std::conditional<N == 0, std::vector<V>, V[N ? N : 1]>::type;
+    template <typename V>
+    using matrix = typename std::conditional<N == 0, std::vector<V>, V[N ? N*N : 1]>::type;
+
+    template <typename V>
+    static void resize(std::vector<V>& v, unsigned s) {v.resize(std::max(s, 1u));}
+    template <typename V, std::size_t S>
+    static void resize(V (&)[S], unsigned) {}
+
+    // The number of states, a constant for the fixed-size kernels
+    unsigned dim() const {return N ? N : states;}
+
+    unsigned states;
+    filter_solver solver;
+
+    // The model
+    alignas(32) matrix<C> a;
+    alignas(32) array<C> b, c;
+    C d;
+    // The states
+    alignas(32) array<T> xs[ss_kernel<T,C>::slots];
+    // The stages and scratch vectors of the solvers
+    alignas(32) array<T> k[7];
+    alignas(32) array<T> xt, xf, xh;
+    // The LU factorization of I - gamma h A, its row permutation in each
+    // lane and the step it is built for
+    alignas(32) matrix<C> lu;
+    array<std::array<unsigned,ss_lanes<C>::size>> perm;
+    double lu_h;
+
+    // Computes C x
+    T project(const T* x) const
+    {
+        const unsigned n = dim();
+        T y = T();
+        for (unsigned j=0; j<n; j++) y += c[j]*x[j];
+        return y;
+    }
+
+    // Computes dx = A x + B u
+    void deriv(T* dx, const T* x, const T& u) const
+    {
+        const unsigned n = dim();
+        for (unsigned i=0; i<n; i++)
+        {
+            T s = b[i]*u;
+            for (unsigned j=0; j<n; j++) s += a[i*n+j]*x[j];
+            dx[i] = s;
+        }
+    }
+
+    // The classical Runge-Kutta step over the part [th, th+dth] of the input
+    void rk4(T* xn, const T* x, double h, const input_type& u, double th, double dth)
+    {
+        const unsigned n = dim();
+        const T u0 = u(th), um = u(th+dth/2), u1 = u(th+dth);
+        deriv(&k[0][0], x, u0);
+        for (unsigned i=0; i<n; i++) xt[i] = x[i] + (h/2)*k[0][i];
+        deriv(&k[1][0], &xt[0], um);
+        for (unsigned i=0; i<n; i++) xt[i] = x[i] + (h/2)*k[1][i];
+        deriv(&k[2][0], &xt[0], um);
+        for (unsigned i=0; i<n; i++) xt[i] = x[i] + h*k[2][i];
+        deriv(&k[3][0], &xt[0], u1);
+        for (unsigned i=0; i<n; i++)
+            xn[i] = x[i] + (h/6)*(k[0][i] + 2.0*k[1][i] + 2.0*k[2][i] + k[3][i]);
+    }
+
+    // The Dormand-Prince 5(4) step
+    void dopri5(T* xn, const T* x, double h, const input_type& u, double* err)
+    {
+        static const double cs[7] = {0, 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1, 1};
+        static const double as[7][6] = {
+            {},
+            {1.0/5},
+            {3.0/40, 9.0/40},
+            {44.0/45, -56.0/15, 32.0/9},
+            {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+            {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+            {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84}
+        };
+        // The differences of the weights of the 5th and 4th order solutions
+        static const double es[7] = {71.0/57600, 0, -71.0/16695, 71.0/1920,
+                                     -17253.0/339200, 22.0/525, -1.0/40};
+        const unsigned n = dim();
+        deriv(&k[0][0], x, u(0));
+        for (unsigned s=1; s<7; s++)
+        {
+            // The last stage is the new state, only needed for the error
+            T* xs_ = s < 6 ? &xt[0] : xn;
+            for (unsigned i=0; i<n; i++)
+            {
+                T v = T();
+                for (unsigned j=0; j<s; j++) v += as[s][j]*k[j][i];
+                xs_[i] = x[i] + h*v;
+            }
+            if (s == 6 && !err) return;
+            deriv(&k[s][0], xs_, u(cs[s]));
+        }
+        for (unsigned i=0; i<n; i++)
+        {
+            T v = T();
+            for (unsigned j=0; j<7; j++) v += es[j]*k[j][i];
+            xf[i] = v;
+        }
+        *err = (double)norm_inf(project(&xf[0]));
+    }
+
+    // The ROS2 Rosenbrock step with the exact Jacobian A
+    void rosenbrock(T* xn, const T* x, double h, const input_type& u, double* err)
+    {
+        const unsigned n = dim();
+        const double gamma = 1 + 1/std::sqrt(2.0);
+        if (h != lu_h) factorize(gamma*h);
+        lu_h = h;
+        const T u0 = u(0), u1 = u(1);
+        // The time derivative term of the linear input over the step
+        const T ud = (gamma*h)*(u1 - u0);
+        deriv(&k[0][0], x, u0);
+        for (unsigned i=0; i<n; i++) k[0][i] = h*k[0][i] + b[i]*ud;
+        solve(&k[0][0]);
+        for (unsigned i=0; i<n; i++) xt[i] = x[i] + k[0][i];
+        deriv(&k[1][0], &xt[0], u1);
+        for (unsigned i=0; i<n; i++) k[1][i] = h*k[1][i] - 2.0*k[0][i] - b[i]*ud;
+        solve(&k[1][0]);
+        for (unsigned i=0; i<n; i++)
+            xn[i] = x[i] + 1.5*k[0][i] + 0.5*k[1][i];
+        if (err)
+        {
+            // Compared to the linearly implicit Euler step
+            for (unsigned i=0; i<n; i++) xf[i] = 0.5*(k[0][i] + k[1][i]);
+            *err = (double)norm_inf(project(&xf[0]))/h;
+        }
+    }
+
+    // Factorizes I - g A with partial pivoting in each lane
+    void factorize(double g)
+    {
+        const unsigned n = dim();
+        for (unsigned i=0; i<n*n; i++) lu[i] = -g*a[i];
+        for (unsigned i=0; i<n; i++)
+        {
+            lu[i*n+i] += C(1);
+            perm[i].fill(i);
+        }
+        for (std::size_t l=0; l<ss_lanes<C>::size; l++)
+        {
+            auto e = [&](unsigned i, unsigned j) -> auto&
+                     {
+                         return ss_lanes<C>::at(lu[i*n+j], l);
+                     };
+            for (unsigned p=0; p<n; p++)
+            {
+                unsigned m = p;
+                for (unsigned i=p+1; i<n; i++)
+                    if (std::abs(e(i,p)) > std::abs(e(m,p))) m = i;
+                if (m != p)
+                {
+                    for (unsigned j=0; j<n; j++) std::swap(e(p,j), e(m,j));
+                    std::swap(perm[p][l], perm[m][l]);
+                }
+                for (unsigned i=p+1; i<n; i++)
+                {
+                    auto f = e(i,p) /= e(p,p);
+                    for (unsigned j=p+1; j<n; j++) e(i,j) -= f*e(p,j);
+                }
+            }
+        }
+    }
+
+    // Solves (I - g A) v = r in place
+    void solve(T* r)
+    {
+        const unsigned n = dim();
+        // Permutes the rows, then substitutes in all lanes together
+        for (unsigned i=0; i<n; i++)
+            if constexpr (ss_lanes<C>::size == 1)
+                xh[i] = r[perm[i][0]];
+            else
+                for (std::size_t l=0; l<ss_lanes<C>::size; l++)
+                    ss_lanes<T>::at(xh[i], l) = ss_lanes<T>::at(r[perm[i][l]], l);
+        for (unsigned i=0; i<n; i++)
+            for (unsigned j=0; j<i; j++) xh[i] -= lu[i*n+j]*xh[j];
+        for (unsigned i=n; i-- > 0;)
+        {
+            for (unsigned j=i+1; j<n; j++) xh[i] -= lu[i*n+j]*xh[j];
+            xh[i] = xh[i]/lu[i*n+i];
+            r[i] = xh[i];
+        }
+    }
+};
+
+//! Interleaves the coefficients of N filters into the lanes of ct_vectors
+/*! The coefficients of each filter are given in descending powers of s.
+ * Shorter lists are padded with leading zeros, which is only allowed for
+ * the numerators, so the denominators should all be of the same length.
+ */
+template <typename T, std::size_t N>
+inline std::vector<ct_vector<T,N>> interleave_coefs(const std::vector<std::vector<T>>& coefs,
+                                                   bool pad)
+{
+    if (coefs.size() != N)
+        SC_REPORT_ERROR("ForSyDe::interleave_coefs",
+                        "the coefficients of each filter of the bank are needed");
+    std::size_t len = 0;
+    for (auto& c : coefs) len = std::max(len, c.size());
+    std::vector<ct_vector<T,N>> res(len);
+    for (std::size_t f=0; f<coefs.size() && f<N; f++)
+    {
+        const std::vector<T>& c = coefs[f];
+        if (!pad && c.size() != len)
+            SC_REPORT_ERROR("ForSyDe::interleave_coefs",
+                            "the filters of a bank should be of the same order");
+        for (std::size_t i=0; i<c.size(); i++) res[len-c.size()+i][f] = c[i];
+    }
+    return res;
+}
+
+//! Builds the kernel of the transfer function num/den
+/*! The coefficients are given in descending powers of s, and the degree
+ * of the numerator should not exceed that of the denominator. Filters of
+ * orders up to FORSYDE_FIXED_FILTER_ORDER use the fixed-size kernels.
+ */
+template <typename T, typename C=T, unsigned N=FORSYDE_FIXED_FILTER_ORDER>
+inline ss_kernel<T,C>* make_ss_kernel(const std::vector<C>& num,
+                                      const std::vector<C>& den,
+                                      filter_solver solver=RK4)
+{
+    if constexpr (N == 0)
+    {
+        if (den.empty() || num.size() > den.size())
+            SC_REPORT_ERROR("ForSyDe::make_ss_kernel",
+                            "the degree of the numerator should not exceed the denominator");
+        return new basic_ss_kernel<T,C,0>(num, den, solver);
+    }
+    else
+    {
+        if (den.size() == N+1 && num.size() <= N+1)
+            return new basic_ss_kernel<T,C,N>(num, den, solver);
+        return make_ss_kernel<T,C,N-1>(num, den, solver);
+    }
+}
+
+}
+
+#endif
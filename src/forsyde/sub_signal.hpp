@@ -18,80 +18,255 @@
  * \brief Implements the sub-components of a CT signal
  */
 
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+#include "ct_vector.hpp"
+
 namespace ForSyDe
 {
 
 using namespace sc_core;
 
-//! Type of the values used in the CT MoC (currently fixed)
+//! Type of the values used by default in the CT MoC
 typedef double CTTYPE;
 
+//! A closed-form shape of a sub-signal
+/*! The shape is a cubic polynomial plus up to max_sines sinusoids,
+ * stored inline:
+ * 
+ *   f(t) = c0 + c1*x + c2*x^2 + c3*x^3 + sum(s_i*sin(w_i*x) + k_i*cos(w_i*x))
+ * 
+ * where x = t - origin in seconds. It covers the constant, linear and
+ * cubic interpolations and the sinusoidal sources without allocating a
+ * closure, and it is closed under shifting, scaling and (as long as the
+ * sinusoids fit) addition.
+ * 
+ * The coefficients are of the value type T of the signal, so that the
+ * sinusoids of all elements of a vector value share their frequencies.
+ */
+template <typename T>
+class basic_poly_shape
+{
+public:
+    //! The maximum number of sinusoids with different frequencies
+    static const unsigned max_sines = 2;
+    
+    //! The zero shape
+    basic_poly_shape() : origin(0), c(), sines(0), sa(), ca(), omega() {}
+    
+    //! A constant shape
+    static basic_poly_shape constant(const T& v)
+    {
+        basic_poly_shape s;
+        s.c[0] = v;
+        return s;
+    }
+    
+    //! A polynomial shape in the time since origin
+    static basic_poly_shape polynomial(const sc_time& origin, const T& c0,
+                                       const T& c1=T(), const T& c2=T(),
+                                       const T& c3=T())
+    {
+        basic_poly_shape s;
+        s.origin = origin.to_seconds();
+        s.c[0] = c0; s.c[1] = c1; s.c[2] = c2; s.c[3] = c3;
+        return s;
+    }
+    
+    //! The cubic Hermite interpolation over h seconds since origin
+    /*! It goes from y0 with the derivative d0 to y1 with the derivative d1.
+     */
+    static basic_poly_shape hermite(const sc_time& origin, double h,
+                                    const T& y0, const T& y1,
+                                    const T& d0, const T& d1)
+    {
+        T dy = (y1 - y0)/h;
+        return polynomial(origin, y0, d0, (3.0*dy - 2.0*d0 - d1)/h,
+                          (d0 + d1 - 2.0*dy)/(h*h));
+    }
+    
+    //! A sinusoid ampl*sin(omega*x + phase) in the time since origin
+    static basic_poly_shape sinusoid(const T& ampl, double omega, double phase=0,
+                                     const sc_time& origin=SC_ZERO_TIME)
+    {
+        basic_poly_shape s;
+        s.origin = origin.to_seconds();
+        s.sines = 1;
+        s.sa[0] = ampl*std::cos(phase);
+        s.ca[0] = ampl*std::sin(phase);
+        s.omega[0] = omega;
+        return s;
+    }
+    
+    //! Evaluates the shape at t seconds
+    T operator() (double t) const
+    {
+        double x = t - origin;
+        T v = ((c[3]*x + c[2])*x + c[1])*x + c[0];
+        for (unsigned i=0; i<sines; i++)
+            v += sa[i]*std::sin(omega[i]*x) + ca[i]*std::cos(omega[i]*x);
+        return v;
+    }
+    
+    //! Evaluates the shape at time t
+    T operator() (const sc_time& t) const
+    {
+        return (*this)(t.to_seconds());
+    }
+    
+    //! Evaluates the shape at the n instants t0, t0+dt, ... seconds
+    /*! The polynomial and each of the sinusoids are evaluated for all
+     * instants in separate loops without dependencies between the
+     * iterations, which the compilers vectorize.
+     */
+    void sample(T* out, double t0, double dt, std::size_t n) const
+    {
+        const double x0 = t0 - origin;
+        for (std::size_t i=0; i<n; i++)
+        {
+            double x = x0 + i*dt;
+            out[i] = ((c[3]*x + c[2])*x + c[1])*x + c[0];
+        }
+        for (unsigned j=0; j<sines; j++)
+            for (std::size_t i=0; i<n; i++)
+            {
+                double x = omega[j]*(x0 + i*dt);
+                out[i] += sa[j]*std::sin(x) + ca[j]*std::cos(x);
+            }
+    }
+    
+    //! Moves the shape d seconds later
+    void shift(double d)
+    {
+        origin += d;
+    }
+    
+    //! Multiplies the shape by k
+    void scale(const T& k)
+    {
+        for (int i=0; i<4; i++) c[i] = k*c[i];
+        for (unsigned i=0; i<sines; i++)
+        {
+            sa[i] = k*sa[i];
+            ca[i] = k*ca[i];
+        }
+    }
+    
+    //! Adds k times another shape
+    /*! The sinusoids of equal frequencies are merged. Returns false, and
+     * leaves the shape unchanged, if the sum has too many sinusoids.
+     */
+    bool add(const basic_poly_shape& o, const T& k=T(1))
+    {
+        basic_poly_shape r = *this;
+        // The time since the origin of o at x
+        double d = origin - o.origin;
+        for (unsigned j=0; j<o.sines; j++)
+        {
+            // The sinusoid of o rotated to the origin of r
+            double cd = std::cos(o.omega[j]*d), sd = std::sin(o.omega[j]*d);
+            T s = k*(o.sa[j]*cd - o.ca[j]*sd);
+            T q = k*(o.sa[j]*sd + o.ca[j]*cd);
+            unsigned i = 0;
+            while (i<r.sines && r.omega[i]!=o.omega[j]) i++;
+            if (i == r.sines)
+            {
+                if (r.sines == max_sines) return false;
+                r.sa[i] = s; r.ca[i] = q; r.omega[i] = o.omega[j];
+                r.sines++;
+            }
+            else
+            {
+                r.sa[i] += s;
+                r.ca[i] += q;
+            }
+        }
+        // The polynomial of o expanded around the origin of r
+        r.c[0] += k*(((o.c[3]*d + o.c[2])*d + o.c[1])*d + o.c[0]);
+        r.c[1] += k*((o.c[3]*(3*d) + o.c[2]*2)*d + o.c[1]);
+        r.c[2] += k*(o.c[3]*(3*d) + o.c[2]);
+        r.c[3] += k*o.c[3];
+        *this = r;
+        return true;
+    }
+    
+private:
+    double origin;
+    T c[4];
+    unsigned sines;
+    T sa[max_sines];
+    T ca[max_sines];
+    double omega[max_sines];
+};
+
+//! The closed-form shapes of the default CT value type
+typedef basic_poly_shape<CTTYPE> poly_shape;
+
 //! The sub-signal type used to construct a CT signal
 /*! This class is used to build a sub-signal which is a function that is
  * valid on a range. A consecutive stream of tokens of type sub_signal
  * forms a CT signal.
  * 
  * The range is defined by a start time and and end time of type sc_time.
- * The supplied fuction can be a function pointer, a function object or
- * a C++11 lambda function.
+ * The function over the range is either a closed-form poly_shape, which
+ * is stored inline, or an arbitrary function which can be a function
+ * pointer, a function object or a C++11 lambda function.
+ * 
+ * The values of the function are of type T, which can be a scalar or a
+ * fixed-width ct_vector carrying several channels.
  */
-class sub_signal
+template <typename T>
+class basic_sub_signal
 {
 public:
     
-    typedef std::function<CTTYPE(const sc_time&)> functype;
+    typedef T value_type;
+    typedef basic_poly_shape<T> shapetype;
+    typedef std::function<T(const sc_time&)> functype;
     
     //! The constructor used for sub-signal definition
     /*! 
      */
-    sub_signal(const sc_time& st,         ///< Beginning of the range
-               const sc_time& et,         ///< End of the range
-               const functype& f) ///< The function over the range
-        : start_time(st), end_time(et), _f(f) {}
-    
-    //! A dummy constructor used for sub-signal definition without initialization
-    /*! 
-     */
-    sub_signal() {}
+    basic_sub_signal(const sc_time& st,         ///< Beginning of the range
+                     const sc_time& et,         ///< End of the range
+                     const functype& f) ///< The function over the range
+        : start_time(st), end_time(et), has_shape(false), _f(f) {}
     
-    //! The copy constructor
+    //! The constructor used for sub-signals with a closed-form shape
     /*! 
      */
-    sub_signal(const sub_signal& ss       ///< Object to be copied
-              )
-        : start_time(get_start_time(ss)), end_time(get_end_time(ss)), _f(get_function(ss)) {}
+    basic_sub_signal(const sc_time& st,         ///< Beginning of the range
+                     const sc_time& et,         ///< End of the range
+                     const shapetype& s)        ///< The shape over the range
+        : start_time(st), end_time(et), has_shape(true), shape(s) {}
     
-    //! The assignment operator
+    //! A dummy constructor used for sub-signal definition without initialization
     /*! 
      */
-    sub_signal& operator=(const sub_signal& ss  ///< Object to be assigned
-                        ){
-        start_time = get_start_time(ss);
-        end_time = get_end_time(ss);
-        _f = get_function(ss);
-        return *this;
-    }
+    basic_sub_signal() : has_shape(false) {}
     
     //! The overloaded () operator makes the sub-signal a function object
     /*! It allows to sample the signal with a convinient syntax.
      * Additionally, it checks the sampling time validity with respect
      * to the range.
      */
-    CTTYPE operator() (const sc_time& valAt) const
+    T operator() (const sc_time& valAt) const
     {
         if ((valAt>=start_time) && (valAt<end_time))
-            return _f(valAt);
+            return has_shape ? shape(valAt) : _f(valAt);
         else
         {
             SC_REPORT_ERROR("Using ForSyDe::CT","Access out of sub-signal range");
-            return -1;
+            return T();
         }
     }
     
     //! A helper function used to get the beginning of the range
     /*! 
      */
-    inline friend sc_time get_start_time(const sub_signal& ss)
+    inline friend sc_time get_start_time(const basic_sub_signal& ss)
     {
         return ss.start_time;
     }
@@ -99,23 +274,65 @@ public:
     //! A helper function used to get the end of the range
     /*! 
      */
-    inline friend sc_time get_end_time(const sub_signal& ss)
+    inline friend sc_time get_end_time(const basic_sub_signal& ss)
     {
         return ss.end_time;
     }
     
+    //! A helper function used to count the instants t, t+period, ... before the end of the range
+    /*! 
+     */
+    inline friend std::size_t count_samples(const basic_sub_signal& ss,
+                                            const sc_time& t, const sc_time& period)
+    {
+        if (t >= ss.end_time) return 0;
+        return ((ss.end_time - t).value() - 1)/period.value() + 1;
+    }
+    
+    //! A helper function used to sample the sub-signal at n instants
+    /*! The instants are t, t+period, ... and they should be in the range.
+     * A closed-form shape is evaluated at all of them at once, while a
+     * function is called for each of them.
+     */
+    inline friend void sample_n(const basic_sub_signal& ss, const sc_time& t,
+                                const sc_time& period, std::size_t n, T* out)
+    {
+        if (n == 0) return;
+        if (t < ss.start_time ||
+            t.value() + (n-1)*period.value() >= ss.end_time.value())
+        {
+            SC_REPORT_ERROR("Using ForSyDe::CT","Access out of sub-signal range");
+            return;
+        }
+        if (ss.has_shape)
+            ss.shape.sample(out, t.to_seconds(), period.to_seconds(), n);
+        else
+            for (std::size_t i=0; i<n; i++)
+                out[i] = ss._f(sc_time::from_value(t.value() + i*period.value()));
+    }
+    
     //! A helper function used to get the functions in range
+    /*! A closed-form shape is wrapped in a new function object.
+     */
+    inline friend functype get_function(const basic_sub_signal& ss)
+    {
+        if (!ss.has_shape) return ss._f;
+        shapetype s = ss.shape;
+        return [s](const sc_time& t) {return s(t);};
+    }
+    
+    //! A helper function used to get the closed-form shape, if any
     /*! 
      */
-    inline friend std::function<CTTYPE(const sc_time&)> get_function(const sub_signal& ss)
+    inline friend const shapetype* get_shape(const basic_sub_signal& ss)
     {
-        return ss._f;
+        return ss.has_shape ? &ss.shape : NULL;
     }
 
     //! A helper function used to set the start and end of the range
     /*! 
      */
-    inline friend void set_range(sub_signal& ss, sc_time st, sc_time et)
+    inline friend void set_range(basic_sub_signal& ss, sc_time st, sc_time et)
     {
         ss.start_time = st;
         ss.end_time = et;
@@ -124,12 +341,23 @@ public:
     //! A helper function used to set the function in the range
     /*! 
      */
-    inline friend void set_function(sub_signal& ss, const std::function<CTTYPE(const sc_time&)>& f)
+    inline friend void set_function(basic_sub_signal& ss, const functype& f)
     {
+        ss.has_shape = false;
         ss._f = f;
     }
     
-    friend std::ostream& operator<< (std::ostream& os, sub_signal &subSig)
+    //! A helper function used to set a closed-form shape in the range
+    /*! 
+     */
+    inline friend void set_shape(basic_sub_signal& ss, const shapetype& s)
+    {
+        ss.has_shape = true;
+        ss.shape = s;
+        ss._f = nullptr;
+    }
+    
+    friend std::ostream& operator<< (std::ostream& os, basic_sub_signal &subSig)
     {
         os << "(" << get_start_time(subSig) << ", " 
            << get_end_time(subSig) << ") -> f";
@@ -138,8 +366,13 @@ public:
 private:
     sc_time start_time;
     sc_time end_time;
+    bool has_shape;
+    shapetype shape;
     functype _f;
 };
 
+//! The sub-signals of the default CT value type
+typedef basic_sub_signal<CTTYPE> sub_signal;
+
 }
 #endif
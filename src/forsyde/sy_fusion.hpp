@@ -0,0 +1,153 @@
+/**********************************************************************
+    * sy_fusion.hpp -- Fusion of chains of SY combinational processes *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Providing an elaboration pass which fires chains of    *
+    *          combinational processes from a single thread           *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef SY_FUSION_HPP
+#define SY_FUSION_HPP
+
+/*! \file sy_fusion.hpp
+ * \brief Implements the fusion of chains of SY combinational processes
+ *
+ *  This file includes an optional elaboration pass which detects linear
+ * chains of combinational processes in the SY MoC and fires each of them
+ * as a single process.
+ */
+
+#include <vector>
+#include <map>
+
+#include "sy_process.hpp"
+
+namespace ForSyDe
+{
+
+namespace SY
+{
+
+using namespace sc_core;
+
+//! An elaboration pass which fuses chains of SY combinational processes
+/*! When instantiated inside a (composite) module, the pass looks for
+ * chains of combinational processes in the hierarchy of its parent
+ * module at the end of elaboration. A chain starts with any of the
+ * comb, comb2, comb3, comb4 or combX processes and continues with comb
+ * processes, where each process drives a signal which is read only by
+ * the next one.
+ *
+ * During the simulation, the threads of all processes of a chain but
+ * the first terminate immediately. Each time the first process fires,
+ * it passes its output token directly to the next process, which
+ * applies its function and passes the result further, until the last
+ * process writes to its output signal. Hence, the signals inside a
+ * chain remain empty, while the signals at its boundaries carry the
+ * same tokens as in the threaded execution with fewer threads, FIFO
+ * accesses and delta cycles.
+ */
+class comb_fusion : public sc_module
+{
+public:
+    //! The constructor requires the module name
+    comb_fusion(sc_module_name _name        ///< The name of the pass
+               ) : sc_module(_name) {}
+
+    //! The pass is not a ForSyDe process and is skipped by introspection
+    virtual const char* kind() const {return "forsyde_comb_fusion";}
+
+    //! The fused chains, each one starting with the process which fires it
+    const std::vector<std::vector<sy_process*>>& chains() const {return fused_chains;}
+
+private:
+    std::vector<sy_process*> procs;
+    std::vector<std::vector<sy_process*>> fused_chains;
+
+    //! This hook is used to detect and link the chains
+    void end_of_elaboration()
+    {
+        sc_object* top = get_parent_object();
+        if (top != NULL)
+            collect(top->get_child_objects());
+        else
+            collect(sc_get_top_level_objects());
+
+        link_chains();
+    }
+
+    //! The processes fired by their predecessors are initialized here
+    void start_of_simulation()
+    {
+        for (auto ch=fused_chains.begin();ch!=fused_chains.end();ch++)
+            for (auto it=ch->begin()+1;it!=ch->end();it++)
+                dynamic_cast<fusible*>(*it)->init_fused();
+    }
+
+    //! Recursively collects the fusible processes
+    void collect(const std::vector<sc_object*>& objs)
+    {
+        for (auto it=objs.begin();it!=objs.end();it++)
+        {
+            if (sy_process* p = dynamic_cast<sy_process*>(*it))
+            {
+                if (!p->externally_scheduled && dynamic_cast<fusible*>(p) != NULL)
+                    procs.push_back(p);
+            }
+            else if (dynamic_cast<sc_module*>(*it) != NULL)
+                collect((*it)->get_child_objects());
+        }
+    }
+
+    //! Links each process to the only reader of its output signal
+    void link_chains()
+    {
+        size_t n = procs.size();
+        std::vector<fusible*> stages(n);
+        std::map<sc_interface*, size_t> readers;
+        for (size_t i=0; i<n; i++)
+        {
+            stages[i] = dynamic_cast<fusible*>(procs[i]);
+            untyped_port* port = stages[i]->fusion_input();
+            if (port != NULL && port->channel_count() == 1)
+                readers[port->channel(0)] = i;
+        }
+
+        std::vector<long> succ(n, -1), pred(n, -1);
+        for (size_t i=0; i<n; i++)
+        {
+            untyped_port* port = stages[i]->fusion_output();
+            if (port->channel_count() != 1) continue;
+            auto rd = readers.find(port->channel(0));
+            if (rd == readers.end()) continue;
+            size_t j = rd->second;
+            // A chain which is closed into a loop would have no thread to fire it
+            bool loop = false;
+            for (long k=j; k!=-1 && !loop; k=succ[k])
+                loop = (size_t)k == i;
+            if (loop || !stages[i]->fuse(stages[j])) continue;
+            succ[i] = j;
+            pred[j] = i;
+            procs[j]->externally_scheduled = true;
+        }
+
+        for (size_t i=0; i<n; i++)
+        {
+            if (pred[i] != -1 || succ[i] == -1) continue;
+            std::vector<sy_process*> chain;
+            for (long k=i; k!=-1; k=succ[k])
+                chain.push_back(procs[k]);
+            fused_chains.push_back(chain);
+        }
+    }
+};
+
+}
+}
+
+#endif
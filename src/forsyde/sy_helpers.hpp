@@ -57,6 +57,30 @@ inline comb<T0,T1>* make_comb(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a comb process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class F>
+inline comb<T0,T1,std::decay_t<F>>* make_comb_inline(const std::string& pName,
+    F&& _func,
+    OIf<T0>& outS,
+    I1If<T1>& inp1S
+    )
+{
+    auto p = new comb<T0,T1,std::decay_t<F>>(pName.c_str(), _func);
+    
+    (*p).iport1(inp1S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb2 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -83,6 +107,33 @@ inline comb2<T0,T1,T2>* make_comb2(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a comb2 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class F>
+inline comb2<T0,T1,T2,std::decay_t<F>>* make_comb2_inline(const std::string& pName,
+    F&& _func,
+    OIf<T0>& outS,
+    I1If<T1>& inp1S,
+    I2If<T2>& inp2S
+    )
+{
+    auto p = new comb2<T0,T1,T2,std::decay_t<F>>(pName.c_str(), _func);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb3 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -112,6 +163,36 @@ inline comb3<T0,T1,T2,T3>* make_comb3(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a comb3 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class T3, template <class> class I3If,
+          class F>
+inline comb3<T0,T1,T2,T3,std::decay_t<F>>* make_comb3_inline(const std::string& pName,
+    F&& _func,
+    OIf<T0>& outS,
+    I1If<T1>& inp1S,
+    I2If<T2>& inp2S,
+    I3If<T3>& inp3S
+    )
+{
+    auto p = new comb3<T0,T1,T2,T3,std::decay_t<F>>(pName.c_str(), _func);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).iport3(inp3S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb4 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -144,6 +225,39 @@ inline comb4<T0,T1,T2,T3,T4>* make_comb4(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a comb4 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class T3, template <class> class I3If,
+          class T4, template <class> class I4If,
+          class F>
+inline comb4<T0,T1,T2,T3,T4,std::decay_t<F>>* make_comb4_inline(const std::string& pName,
+    F&& _func,
+    OIf<T0>& outS,
+    I1If<T1>& inp1S,
+    I2If<T2>& inp2S,
+    I3If<T3>& inp3S,
+    I4If<T4>& inp4S
+    )
+{
+    auto p = new comb4<T0,T1,T2,T3,T4,std::decay_t<F>>(pName.c_str(), _func);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).iport3(inp3S);
+    (*p).iport4(inp4S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a combX process
 /*! This function is used to construct a process (SystemC module) and
  * connect its input and output signals.
@@ -169,6 +283,32 @@ inline combX<T0,T1,N>* make_combX(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a combX process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class IIf,
+          std::size_t N,
+          class F>
+inline combX<T0,T1,N,std::decay_t<F>>* make_combX_inline(const std::string& pName,
+    F&& _func,
+    OIf<T0>& outS,
+    std::array<IIf<T1>,N>& inpS
+    )
+{
+    auto p = new combX<T0,T1,N,std::decay_t<F>>(pName.c_str(), _func);
+
+    for (int i=0;i<N;i++)
+    	(*p).iport[i](inpS[i]);
+    (*p).oport1(outS);
+
+    return p;
+}
+
 // //! Helper function to construct a combN process
 // /*! This function is used to construct a process (SystemC module) and
 //  * connect its input and output signals.
@@ -265,6 +405,33 @@ inline moore<IT,ST,OT>* make_moore(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a moore process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <typename IT, typename ST, typename OT,
+           template <class> class IIf,
+           template <class> class OIf,
+           class NsF, class OdF>
+inline moore<IT,ST,OT,std::decay_t<NsF>,std::decay_t<OdF>>* make_moore_inline(const std::string& pName,
+    NsF&& _ns_func,
+    OdF&& _od_func,
+    const ST& init_st,
+    OIf<OT>& outS,
+    IIf<IT>& inpS
+    )
+{
+    auto p = new moore<IT,ST,OT,std::decay_t<NsF>,std::decay_t<OdF>>(pName.c_str(), _ns_func, _od_func, init_st);
+    
+    (*p).iport1(inpS);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a mealy process
 /*! This function is used to construct a mealy process (SystemC module) and
  * connect its output and output signals.
@@ -291,6 +458,33 @@ inline mealy<IT,ST,OT>* make_mealy(const std::string& pName,
     return p;
 }
 
+//! Helper function to construct a mealy process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <typename IT, typename ST, typename OT,
+           template <class> class IIf,
+           template <class> class OIf,
+           class NsF, class OdF>
+inline mealy<IT,ST,OT,std::decay_t<NsF>,std::decay_t<OdF>>* make_mealy_inline(const std::string& pName,
+    NsF&& _ns_func,
+    OdF&& _od_func,
+    const ST& init_st,
+    OIf<OT>& outS,
+    IIf<IT>& inpS
+    )
+{
+    auto p = new mealy<IT,ST,OT,std::decay_t<NsF>,std::decay_t<OdF>>(pName.c_str(), _ns_func, _od_func, init_st);
+    
+    (*p).iport1(inpS);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a fill process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -30,6 +30,7 @@
 #include "sy_helpers.hpp"
 #include "sy_process_constructors_strict.hpp"
 #include "sy_helpers_strict.hpp"
+#include "sy_fusion.hpp"
 
 namespace ForSyDe
 {
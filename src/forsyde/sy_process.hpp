@@ -94,6 +94,50 @@ using out_port = SY_out<T>;
 //! Abstract semantics of a process in the SY MoC
 typedef ForSyDe::process sy_process;
 
+//! Interface of the SY processes which can be fused with their successor
+/*! A chain of such processes can be fired from the thread of its first
+ * process, where each process passes its output token directly to the
+ * next one instead of writing it to a signal (see comb_fusion).
+ */
+class fusible
+{
+public:
+    //! The input port through which the process is fed by its predecessor, or NULL
+    virtual untyped_port* fusion_input() = 0;
+    
+    //! The output port which feeds the successor of the process
+    virtual untyped_port* fusion_output() = 0;
+    
+    //! Passes the output tokens directly to the successor process
+    /*! Returns false if the successor can not consume the output tokens
+     * of this process.
+     */
+    virtual bool fuse(fusible* next) = 0;
+    
+    //! Runs the init stage of a process which is fired by its predecessor
+    virtual void init_fused() = 0;
+    
+    //! The successor which is fired by this process, or NULL
+    virtual fusible* fused_next() = 0;
+    
+    //! The output port of the last process in the chain fired by this process
+    untyped_port* chain_output()
+    {
+        fusible* p = this;
+        while (p->fused_next() != NULL) p = p->fused_next();
+        return p->fusion_output();
+    }
+};
+
+//! Interface of the SY processes which can be fired by their predecessor
+template <typename T>
+class fused_stage
+{
+public:
+    //! Fires the process on an input token passed by its predecessor
+    virtual void fire_fused(abst_ext<T>&& val) = 0;
+};
+
 }
 }
 
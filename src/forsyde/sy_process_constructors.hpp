@@ -42,16 +42,20 @@ using namespace sc_core;
 /*! This class is used to build combinational processes with one input
  * and one output. The class is parameterized for input and output
  * data-types.
+ * The type of the function defaults to std::function and can be set
+ * to any other callable type (see make_comb) to let the compiler inline
+ * it into the process.
  */
-template <typename T0, typename T1>
-class comb : public sy_process
+template <typename T0, typename T1,
+          typename FuncType = std::function<void(abst_ext<T0>&,const abst_ext<T1>&)>>
+class comb : public sy_process, public fusible, public fused_stage<T1>
 {
 public:
     SY_in<T1>  iport1;       ///< port for the input channel
     SY_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(abst_ext<T0>&,const abst_ext<T1>&)> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -61,7 +65,7 @@ public:
     comb(const sc_module_name& _name,      ///< process name
          const functype& _func             ///< function to be passed
          ) : sy_process(_name), iport1("iport1"), oport1("oport1"),
-             _func(_func)
+             _func(_func), next(NULL)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -76,31 +80,37 @@ public:
 private:
     // Inputs and output variables
     abst_ext<T0>* oval;
-    abst_ext<T1>* ival1;
+    token_view<abst_ext<T1>>* ival1;
     
     //! The function passed to the process constructor
     functype _func;
     
+    //! The successor which is fired directly if the process is fused
+    fused_stage<T0>* next;
+    
     //Implementing the abstract semantics
     void init()
     {
         oval = new abst_ext<T0>;
-        ival1 = new abst_ext<T1>;
+        ival1 = new token_view<abst_ext<T1>>;
     }
     
     void prep()
     {
-        *ival1 = iport1.read();
+        iport1.read_view(*ival1);
     }
     
     void exec()
     {
-        _func(*oval, *ival1);
+        _func(*oval, **ival1);
     }
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        if (next)
+            next->fire_fused(std::move(*oval));
+        else
+            write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -109,6 +119,34 @@ private:
         delete oval;
     }
     
+    // Implementing the fusible interface
+    untyped_port* fusion_input() {return &iport1;}
+    
+    untyped_port* fusion_output() {return &oport1;}
+    
+    bool fuse(fusible* n)
+    {
+        next = dynamic_cast<fused_stage<T0>*>(n);
+        return next != NULL;
+    }
+    
+    void init_fused()
+    {
+        init();
+    }
+    
+    fusible* fused_next()
+    {
+        return dynamic_cast<fusible*>(next);
+    }
+    
+    void fire_fused(abst_ext<T1>&& val)
+    {
+        *ival1 = std::move(val);
+        exec();
+        prod();
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -118,13 +156,26 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = dynamic_cast<sc_object*>(chain_output());
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2>
-class comb2 : public sy_process
+template <typename T0, typename T1, typename T2,
+          typename FuncType = std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
+                                                 const abst_ext<T2>&)>>
+class comb2 : public sy_process, public fusible
 {
 public:
     SY_in<T1> iport1;        ///< port for the input channel 1
@@ -132,8 +183,7 @@ public:
     SY_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
-                                              const abst_ext<T2>&)> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -143,7 +193,7 @@ public:
     comb2(const sc_module_name& _name,      ///< process name
            const functype& _func             ///< function to be passed
           ) : sy_process(_name), iport1("iport1"), iport2("iport2"), oport1("oport1"),
-              _func(_func)
+              _func(_func), next(NULL)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -157,34 +207,40 @@ public:
 private:
     // Inputs and output variables
     abst_ext<T0>* oval;
-    abst_ext<T1>* ival1;
-    abst_ext<T2>* ival2;
+    token_view<abst_ext<T1>>* ival1;
+    token_view<abst_ext<T2>>* ival2;
     
     //! The function passed to the process constructor
     functype _func;
+    
+    //! The successor which is fired directly if the process is fused
+    fused_stage<T0>* next;
 
     //Implementing the abstract semantics
     void init()
     {
         oval = new abst_ext<T0>;
-        ival1 = new abst_ext<T1>;
-        ival2 = new abst_ext<T2>;
+        ival1 = new token_view<abst_ext<T1>>;
+        ival2 = new token_view<abst_ext<T2>>;
     }
     
     void prep()
     {
-        *ival1 = iport1.read();
-        *ival2 = iport2.read();
+        iport1.read_view(*ival1);
+        iport2.read_view(*ival2);
     }
     
     void exec()
     {
-        _func(*oval, *ival1, *ival2);
+        _func(*oval, **ival1, **ival2);
     }
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        if (next)
+            next->fire_fused(std::move(*oval));
+        else
+            write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -194,6 +250,27 @@ private:
         delete oval;
     }
     
+    // Implementing the fusible interface
+    untyped_port* fusion_input() {return NULL;}
+    
+    untyped_port* fusion_output() {return &oport1;}
+    
+    bool fuse(fusible* n)
+    {
+        next = dynamic_cast<fused_stage<T0>*>(n);
+        return next != NULL;
+    }
+    
+    void init_fused()
+    {
+        init();
+    }
+    
+    fusible* fused_next()
+    {
+        return dynamic_cast<fusible*>(next);
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -204,13 +281,28 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(2, {NULL, 1});
+        ins[0].port = &iport1;
+        ins[1].port = &iport2;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = dynamic_cast<sc_object*>(chain_output());
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a combinational process with three inputs and one output
 /*! similar to comb with three inputs
  */
-template <typename T0, typename T1, typename T2, typename T3>
-class comb3 : public sy_process
+template <typename T0, typename T1, typename T2, typename T3,
+          typename FuncType = std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
+                                                 const abst_ext<T2>&,
+                                                 const abst_ext<T3>&)>>
+class comb3 : public sy_process, public fusible
 {
 public:
     SY_in<T1> iport1;        ///< port for the input channel 1
@@ -219,9 +311,7 @@ public:
     SY_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
-                                              const abst_ext<T2>&,
-                                              const abst_ext<T3>&)> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -231,7 +321,7 @@ public:
     comb3(const sc_module_name& _name,      ///< process name
            const functype& _func             ///< function to be passed
           ) : sy_process(_name), iport1("iport1"), iport2("iport2"), iport3("iport3"), 
-              oport1("oport1"), _func(_func)
+              oport1("oport1"), _func(_func), next(NULL)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -246,37 +336,43 @@ public:
 private:
     // Inputs and output variables
     abst_ext<T0>* oval;
-    abst_ext<T1>* ival1;
-    abst_ext<T2>* ival2;
-    abst_ext<T3>* ival3;
+    token_view<abst_ext<T1>>* ival1;
+    token_view<abst_ext<T2>>* ival2;
+    token_view<abst_ext<T3>>* ival3;
 
     //! The function passed to the process constructor
     functype _func;
     
+    //! The successor which is fired directly if the process is fused
+    fused_stage<T0>* next;
+    
     //Implementing the abstract semantics
     void init()
     {
         oval = new abst_ext<T0>;
-        ival1 = new abst_ext<T1>;
-        ival2 = new abst_ext<T2>;
-        ival3 = new abst_ext<T3>;
+        ival1 = new token_view<abst_ext<T1>>;
+        ival2 = new token_view<abst_ext<T2>>;
+        ival3 = new token_view<abst_ext<T3>>;
     }
     
     void prep()
     {
-        *ival1 = iport1.read();
-        *ival2 = iport2.read();
-        *ival3 = iport3.read();
+        iport1.read_view(*ival1);
+        iport2.read_view(*ival2);
+        iport3.read_view(*ival3);
     }
     
     void exec()
     {
-        _func(*oval, *ival1, *ival2, *ival3);
+        _func(*oval, **ival1, **ival2, **ival3);
     }
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        if (next)
+            next->fire_fused(std::move(*oval));
+        else
+            write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -287,6 +383,27 @@ private:
         delete oval;
     }
     
+    // Implementing the fusible interface
+    untyped_port* fusion_input() {return NULL;}
+    
+    untyped_port* fusion_output() {return &oport1;}
+    
+    bool fuse(fusible* n)
+    {
+        next = dynamic_cast<fused_stage<T0>*>(n);
+        return next != NULL;
+    }
+    
+    void init_fused()
+    {
+        init();
+    }
+    
+    fusible* fused_next()
+    {
+        return dynamic_cast<fusible*>(next);
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -298,13 +415,30 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(3, {NULL, 1});
+        ins[0].port = &iport1;
+        ins[1].port = &iport2;
+        ins[2].port = &iport3;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = dynamic_cast<sc_object*>(chain_output());
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a combinational process with four inputs and one output
 /*! similar to comb with four inputs
  */
-template <typename T0, typename T1, typename T2, typename T3, typename T4>
-class comb4 : public sy_process
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename FuncType = std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
+                                                 const abst_ext<T2>&,
+                                                 const abst_ext<T3>&,
+                                                 const abst_ext<T4>&)>>
+class comb4 : public sy_process, public fusible
 {
 public:
     SY_in<T1> iport1;       ///< port for the input channel 1
@@ -314,10 +448,7 @@ public:
     SY_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(abst_ext<T0>&, const abst_ext<T1>&,
-                                             const abst_ext<T2>&,
-                                             const abst_ext<T3>&,
-                                             const abst_ext<T4>&)> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -327,7 +458,7 @@ public:
     comb4(const sc_module_name& _name,      ///< process name
            const functype& _func             ///< function to be passed
           ) : sy_process(_name), iport1("iport1"), iport2("iport2"), 
-              iport3("iport3"), iport4("iport4"), _func(_func)
+              iport3("iport3"), iport4("iport4"), _func(_func), next(NULL)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -342,40 +473,46 @@ public:
 private:
     // Inputs and output variables
     abst_ext<T0>* oval;
-    abst_ext<T1>* ival1;
-    abst_ext<T2>* ival2;
-    abst_ext<T3>* ival3;
-    abst_ext<T4>* ival4;
+    token_view<abst_ext<T1>>* ival1;
+    token_view<abst_ext<T2>>* ival2;
+    token_view<abst_ext<T3>>* ival3;
+    token_view<abst_ext<T4>>* ival4;
     
     //! The function passed to the process constructor
     functype _func;
+    
+    //! The successor which is fired directly if the process is fused
+    fused_stage<T0>* next;
 
     //Implementing the abstract semantics
     void init()
     {
         oval = new abst_ext<T0>;
-        ival1 = new abst_ext<T1>;
-        ival2 = new abst_ext<T2>;
-        ival3 = new abst_ext<T3>;
-        ival4 = new abst_ext<T4>;
+        ival1 = new token_view<abst_ext<T1>>;
+        ival2 = new token_view<abst_ext<T2>>;
+        ival3 = new token_view<abst_ext<T3>>;
+        ival4 = new token_view<abst_ext<T4>>;
     }
     
     void prep()
     {
-        *ival1 = iport1.read();
-        *ival2 = iport2.read();
-        *ival3 = iport3.read();
-        *ival4 = iport4.read();
+        iport1.read_view(*ival1);
+        iport2.read_view(*ival2);
+        iport3.read_view(*ival3);
+        iport4.read_view(*ival4);
     }
     
     void exec()
     {
-        _func(*oval, *ival1, *ival2, *ival3, *ival4);
+        _func(*oval, **ival1, **ival2, **ival3, **ival4);
     }
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        if (next)
+            next->fire_fused(std::move(*oval));
+        else
+            write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -387,6 +524,27 @@ private:
         delete oval;
     }
     
+    // Implementing the fusible interface
+    untyped_port* fusion_input() {return NULL;}
+    
+    untyped_port* fusion_output() {return &oport1;}
+    
+    bool fuse(fusible* n)
+    {
+        next = dynamic_cast<fused_stage<T0>*>(n);
+        return next != NULL;
+    }
+    
+    void init_fused()
+    {
+        init();
+    }
+    
+    fusible* fused_next()
+    {
+        return dynamic_cast<fusible*>(next);
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -399,20 +557,35 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(4, {NULL, 1});
+        ins[0].port = &iport1;
+        ins[1].port = &iport2;
+        ins[2].port = &iport3;
+        ins[3].port = &iport4;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = dynamic_cast<sc_object*>(chain_output());
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a combinational process with an array of inputs and one output
 /*! similar to comb with an array of inputs
  */
-template <typename T0, typename T1, std::size_t N>
-class combX : public sy_process
+template <typename T0, typename T1, std::size_t N,
+          typename FuncType = std::function<void(abst_ext<T0>&, const std::array<abst_ext<T1>,N>&)>>
+class combX : public sy_process, public fusible
 {
 public:
     std::array<SY_in<T1>,N> iport;       ///< port for the input channel 1
     SY_out<T0> oport1;        ///< port for the output channel
 
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(abst_ext<T0>&, const std::array<abst_ext<T1>,N>&)> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -421,7 +594,7 @@ public:
      */
     combX(const sc_module_name& _name,      ///< process name
            const functype& _func             ///< function to be passed
-          ) : sy_process(_name), _func(_func)
+          ) : sy_process(_name), _func(_func), next(NULL)
     {
 #ifdef FORSYDE_INTROSPECTION
         std::string func_name = std::string(basename());
@@ -440,6 +613,9 @@ private:
 
     //! The function passed to the process constructor
     functype _func;
+    
+    //! The successor which is fired directly if the process is fused
+    fused_stage<T0>* next;
 
     //Implementing the abstract semantics
     void init()
@@ -460,7 +636,10 @@ private:
 
     void prod()
     {
-        write_multiport(oport1, *oval);
+        if (next)
+            next->fire_fused(std::move(*oval));
+        else
+            write_multiport(oport1, std::move(*oval));
     }
 
     void clean()
@@ -468,6 +647,27 @@ private:
         delete oval;
     }
 
+    // Implementing the fusible interface
+    untyped_port* fusion_input() {return NULL;}
+    
+    untyped_port* fusion_output() {return &oport1;}
+    
+    bool fuse(fusible* n)
+    {
+        next = dynamic_cast<fused_stage<T0>*>(n);
+        return next != NULL;
+    }
+    
+    void init_fused()
+    {
+        init();
+    }
+    
+    fusible* fused_next()
+    {
+        return dynamic_cast<fusible*>(next);
+    }
+    
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
     {
@@ -478,6 +678,18 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(N, {NULL, 1});
+        for (size_t i=0; i<N; i++)
+            ins[i].port = &iport[i];
+        outs.resize(1, {NULL, 1});
+        outs[0].port = dynamic_cast<sc_object*>(chain_output());
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a combinational process with N inputs and one output
@@ -543,7 +755,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -637,7 +849,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_multiport(port, val), ...);
+                (write_multiport(port, std::move(val)), ...);
             }, *ovals);
         }, oport);
     }
@@ -733,7 +945,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -749,6 +961,17 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a n-delay element
@@ -815,7 +1038,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -838,7 +1061,9 @@ private:
  * Given an initial state, a next-state function, and an output decoding
  * function it creates a Moore process.
  */
-template <class IT, class ST, class OT>
+template <class IT, class ST, class OT,
+          typename NsFuncType = std::function<void(ST&, const ST&, const abst_ext<IT>&)>,
+          typename OdFuncType = std::function<void(abst_ext<OT>&, const ST&)>>
 class moore : public sy_process
 {
 public:
@@ -846,10 +1071,10 @@ public:
     SY_out<OT> oport1;        ///< port for the output channel
     
     //! Type of the next-state function to be passed to the process constructor
-    typedef std::function<void(ST&, const ST&, const abst_ext<IT>&)> ns_functype;
+    typedef NsFuncType ns_functype;
     
     //! Type of the output-decoding function to be passed to the process constructor
-    typedef std::function<void(abst_ext<OT>&, const ST&)> od_functype;
+    typedef OdFuncType od_functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -924,7 +1149,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -943,6 +1168,23 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+    
+    // The first firing only writes the output of the initial state
+    bool reads_inputs() const
+    {
+        return !first_run;
+    }
+#endif
 };
 
 //! Process constructor for a Mealy machine
@@ -950,7 +1192,11 @@ private:
  * Given an initial state, a next-state function, and an output decoding
  * function it creates a Mealy process.
  */
-template <class IT, class ST, class OT>
+template <class IT, class ST, class OT,
+          typename NsFuncType = std::function<void(ST&, const ST&,
+                                                   const abst_ext<IT>&)>,
+          typename OdFuncType = std::function<void(abst_ext<OT>&, const ST&,
+                                                   const abst_ext<IT>&)>>
 class mealy : public sy_process
 {
 public:
@@ -958,12 +1204,10 @@ public:
     SY_out<OT> oport1;        ///< port for the output channel
     
     //! Type of the next-state function to be passed to the process constructor
-    typedef std::function<void(ST&, const ST&, 
-                                                const abst_ext<IT>&)> ns_functype;
+    typedef NsFuncType ns_functype;
     
     //! Type of the output-decoding function to be passed to the process constructor
-    typedef std::function<void(abst_ext<OT>&, const ST&,
-                                                const abst_ext<IT>&)> od_functype;
+    typedef OdFuncType od_functype;
     
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -1028,7 +1272,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -1047,6 +1291,17 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a fill process
@@ -1106,7 +1361,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *oval);
+        write_multiport(oport1, std::move(*oval));
     }
     
     void clean()
@@ -1249,7 +1504,7 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        infinite = take==0 ? true : false;
+        infinite = take==0;
         tok_cnt = 0;
     }
     
@@ -1334,7 +1589,7 @@ private:
         cur_st = new abst_ext<T>;
         *cur_st = init_st;
         write_multiport(oport1, *cur_st);
-        infinite = take==0 ? true : false;
+        infinite = take==0;
         tok_cnt = 1;
     }
     
@@ -1557,7 +1812,7 @@ public:
     std::string forsyde_kind() const {return "SY::sink";}
     
 private:
-    abst_ext<T>* val;         // The current state of the process
+    token_view<abst_ext<T>>* val;   // The current input of the process
 
     //! The function passed to the process constructor
     functype _func;
@@ -1565,17 +1820,17 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        val = new abst_ext<T>;
+        val = new token_view<abst_ext<T>>;
     }
     
     void prep()
     {
-        *val = iport1.read();
+        iport1.read_view(*val);
     }
     
     void exec()
     {
-        _func(*val);
+        _func(**val);
     }
     
     void prod() {}
@@ -1592,6 +1847,15 @@ private:
         boundInChans[0].port = &iport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        return true;
+    }
+#endif
 };
 
 //! Process constructor for a file_sink process
@@ -1707,19 +1971,19 @@ public:
     
 private:
     // intermediate values
-    abst_ext<T1>* ival1;
-    abst_ext<T2>* ival2;
+    token_view<abst_ext<T1>>* ival1;
+    token_view<abst_ext<T2>>* ival2;
     
     void init()
     {
-        ival1 = new abst_ext<T1>;
-        ival2 = new abst_ext<T2>;
+        ival1 = new token_view<abst_ext<T1>>;
+        ival2 = new token_view<abst_ext<T2>>;
     }
     
     void prep()
     {
-        *ival1 = iport1.read();
-        *ival2 = iport2.read();
+        iport1.read_view(*ival1);
+        iport2.read_view(*ival2);
     }
     
     void exec() {}
@@ -1727,15 +1991,15 @@ private:
     void prod()
     {
         typedef std::tuple<abst_ext<T1>,abst_ext<T2>> TT;
-        if (ival1->is_absent() && ival2->is_absent())
+        if ((*ival1)->is_absent() && (*ival2)->is_absent())
         {
             
             write_multiport(oport1,abst_ext<TT>());  // write to the output 1
         }
         else
         {
-            abst_ext<TT> oval(std::make_tuple(*ival1,*ival2));
-            write_multiport(oport1,oval);  // write to the output
+            abst_ext<TT> oval(std::make_tuple(ival1->take(),ival2->take()));
+            write_multiport(oport1,std::move(oval));  // write to the output
         }
     }
     
@@ -1755,6 +2019,18 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(2, {NULL, 1});
+        ins[0].port = &iport1;
+        ins[1].port = &iport2;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+#endif
 };
 
 //! The zipX process with an array of inputs and one output
@@ -1781,14 +2057,14 @@ public:
     
 private:
     // intermediate values
-    std::array<abst_ext<T1>,N> ival;
+    std::array<token_view<abst_ext<T1>>,N> ival;
     
     void init() {}
     
     void prep()
     {
         for (size_t i=0; i<N; i++)
-            ival[i] = iport[i].read();
+            iport[i].read_view(ival[i]);
     }
     
     void exec() {}
@@ -1796,13 +2072,16 @@ private:
     void prod()
     {
         typedef std::array<abst_ext<T1>,N> TT;
-        if (std::all_of(ival.begin(), ival.end(), [](abst_ext<T1> ivalx){return ivalx.is_absent();}))
+        if (std::all_of(ival.begin(), ival.end(), [](const token_view<abst_ext<T1>>& ivalx){return ivalx->is_absent();}))
         {
             write_multiport(oport1,abst_ext<TT>());  // write to the output 1
         }
         else
         {
-            write_multiport(oport1,abst_ext<TT>(ival));  // write to the output
+            TT oval;
+            for (size_t i=0; i<N; i++)
+                oval[i] = ival[i].take();
+            write_multiport(oport1,abst_ext<TT>(std::move(oval)));  // write to the output
         }
     }
     
@@ -1818,6 +2097,18 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(N, {NULL, 1});
+        for (size_t i=0;i<N;i++)
+            ins[i].port = &iport[i];
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+#endif
 };
 
 //! The zip process with variable number of inputs and one output
@@ -1956,6 +2247,18 @@ private:
         boundOutChans[1].port = &oport2;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(2, {NULL, 1});
+        outs[0].port = &oport1;
+        outs[1].port = &oport2;
+        return true;
+    }
+#endif
 };
 
 //! The unzipX process with one input and an array of outputs
@@ -2024,6 +2327,18 @@ private:
             boundOutChans[i].port = &oport[i];
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(N, {NULL, 1});
+        for (size_t i=0;i<N;i++)
+            outs[i].port = &oport[i];
+        return true;
+    }
+#endif
 };
 
 //! The unzip process with one input and variable number of outputs
@@ -2240,30 +2555,27 @@ public:
     std::string forsyde_kind() const {return "SY::fanout";}
     
 private:
-    // Inputs and output variables
-    abst_ext<T>* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const abst_ext<T>> val;
     
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new abst_ext<T>;
-    }
+    void init() {}
     
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
     }
     
     void clean()
     {
-        delete val;
+        val.reset();
     }
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()
@@ -2274,6 +2586,17 @@ private:
         boundOutChans[0].port = &oport1;
     }
 #endif
+    
+#ifdef FORSYDE_COROUTINES
+    bool firingInfo(std::vector<PortInfo>& ins, std::vector<PortInfo>& outs)
+    {
+        ins.resize(1, {NULL, 1});
+        ins[0].port = &iport1;
+        outs.resize(1, {NULL, 1});
+        outs[0].port = &oport1;
+        return true;
+    }
+#endif
 };
 
 }
@@ -1404,7 +1404,7 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        infinite = take==0 ? true : false;
+        infinite = take==0;
         tok_cnt = 0;
     }
     
@@ -1489,7 +1489,7 @@ private:
         cur_st = new T;
         *cur_st = init_st;
         write_multiport(oport1, abst_ext<T>(*cur_st));
-        infinite = take==0 ? true : false;
+        infinite = take==0;
         tok_cnt = 1;
     }
     
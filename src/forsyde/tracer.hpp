@@ -0,0 +1,433 @@
+/**********************************************************************
+    * tracer.hpp -- Tracing the firings of ForSyDe processes          *
+    *                                                                 *
+    * Author:  Hosein Attarzadeh (shan2@kth.se)                       *
+    *                                                                 *
+    * Purpose: Recording a timeline of the process firings and signal *
+    *          occupancies in the Chrome trace-event format           *
+    *                                                                 *
+    * Usage:   This file is included automatically                    *
+    *                                                                 *
+    * License: BSD3                                                   *
+    *******************************************************************/
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+/*! \file tracer.hpp
+ * \brief Implements an optional timeline tracer for processes and signals
+ *
+ *  This file includes a tracer which records the stages of each process
+ * firing and the occupancy of each signal, and writes them as a Chrome
+ * trace-event JSON file which can be opened in chrome://tracing or the
+ * Perfetto UI. The tracer is enabled by defining the FORSYDE_TRACE_EVENTS
+ * macro, and otherwise adds no code to the processes and signals.
+ *
+ * Each process has its own track, on which the prep, exec and prod
+ * stages of its firings are shown with their host (wall-clock) time.
+ * The simulated time and the delta cycle of each firing are attached as
+ * arguments. Each signal has a counter track with the number of tokens
+ * available to its reader after each access by a process.
+ *
+ * The events are stored in fixed-size chunks owned by the recording
+ * thread, so recording an event involves no locks and memory is only
+ * allocated once per chunk. Full chunks are handed over through a
+ * lock-free list to a background thread which formats and writes them
+ * while the simulation continues. The trace is completed at the end of
+ * the simulation and written to FORSYDE_TRACE_FILE (by default
+ * forsyde_trace.json).
+ */
+
+#ifdef FORSYDE_TRACE_EVENTS
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+#ifndef FORSYDE_TRACE_FILE
+#define FORSYDE_TRACE_FILE "forsyde_trace.json"
+#endif
+
+namespace ForSyDe
+{
+
+using namespace sc_core;
+
+//! A single recorded event
+struct trace_event
+{
+    //! A firing of a process or a change of a signal occupancy
+    enum kind_t : uint8_t {FIRING, COUNTER} kind;
+    //! The track of the process or signal
+    uint32_t track;
+    //! Host times in nanoseconds since the start of tracing
+    /*! For a firing, the start of the prep, exec and prod stages and the
+     * end of the prod stage. For a counter, the time of the sample and
+     * the number of tokens.
+     */
+    int64_t times[4];
+    //! The delta cycle when the event started
+    uint64_t delta;
+    //! The simulated time when the event started, in seconds
+    double sim_time;
+};
+
+//! The recorder which collects the events and writes the trace file
+/*! A single instance exists, which is accessed by instance().
+ */
+class trace_recorder
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    //! The only instance of the recorder
+    static trace_recorder& instance()
+    {
+        static trace_recorder rec;
+        return rec;
+    }
+
+    //! Registers a new track and returns its identifier
+    /*! Tracks should be registered during elaboration, before any event
+     * is recorded.
+     */
+    uint32_t add_track(const char* name, bool is_process)
+    {
+        tracks.push_back({name, is_process});
+        if (is_process) processes++;
+        return tracks.size()-1;
+    }
+
+    //! Returns the current host time and remembers it for the current thread
+    int64_t now()
+    {
+        int64_t t = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        clock::now() - origin).count();
+        slot().last = t;
+        return t;
+    }
+
+    //! Records a firing of a process
+    void firing(uint32_t track, const int64_t (&times)[4],
+                uint64_t delta, double sim_time)
+    {
+        if (closed) return;
+        trace_event& ev = next_event();
+        ev.kind = trace_event::FIRING;
+        ev.track = track;
+        std::copy(times, times+4, ev.times);
+        ev.delta = delta;
+        ev.sim_time = sim_time;
+    }
+
+    //! Records the occupancy of a signal
+    /*! To avoid reading the clock on every access, the sample is stamped
+     * with the latest time read by the current thread, i.e., the start
+     * of the stage of the process which accessed the signal.
+     */
+    void counter(uint32_t track, int64_t tokens)
+    {
+        if (closed) return;
+        thread_slot& s = slot();
+        trace_event& ev = next_event();
+        ev.kind = trace_event::COUNTER;
+        ev.track = track;
+        ev.times[0] = s.last;
+        ev.times[1] = tokens;
+        ev.delta = sc_delta_count();
+        ev.sim_time = sc_time_stamp().to_seconds();
+    }
+
+    //! Called by each process at the end of the simulation
+    /*! When all of the registered processes have finished, the pending
+     * events are flushed and the trace file is completed.
+     */
+    void process_finished()
+    {
+        if (++finished == processes) close();
+    }
+
+    ~trace_recorder()
+    {
+        close();
+    }
+
+private:
+    //! A fixed-size block of events filled by a single thread
+    struct chunk
+    {
+        static const size_t capacity = 1024;
+        trace_event events[capacity];
+        size_t size = 0;
+        chunk* next = NULL;
+    };
+
+    //! The chunk being filled by a thread
+    struct thread_slot
+    {
+        chunk* current = NULL;
+        int64_t last = 0;
+        thread_slot* next = NULL;
+    };
+
+    //! The name and type of a track
+    struct track_info
+    {
+        std::string name;
+        bool is_process;
+    };
+
+    std::vector<track_info> tracks;
+    size_t processes = 0;
+    size_t finished = 0;
+    clock::time_point origin;
+    bool closed = false;
+
+    //! The slots of all threads which have recorded events
+    std::atomic<thread_slot*> slots{NULL};
+    //! The full chunks which are not written yet (in reverse order)
+    std::atomic<chunk*> full{NULL};
+    //! Asks the writer thread to terminate after writing all chunks
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+    std::ofstream out;
+    bool first_event = true;
+
+    trace_recorder() : origin(clock::now()) {}
+
+    //! Returns the slot of the current thread
+    thread_slot& slot()
+    {
+        static thread_local thread_slot* s = NULL;
+        if (s == NULL)
+        {
+            s = new thread_slot;
+            s->next = slots.load(std::memory_order_relaxed);
+            while (!slots.compare_exchange_weak(s->next, s, std::memory_order_release,
+                                                std::memory_order_relaxed));
+        }
+        return *s;
+    }
+
+    //! Returns a new event in the chunk of the current thread
+    trace_event& next_event()
+    {
+        thread_slot& s = slot();
+        if (s.current == NULL)
+            s.current = new chunk;
+        else if (s.current->size == chunk::capacity)
+        {
+            submit(s.current);
+            s.current = new chunk;
+        }
+        return s.current->events[s.current->size++];
+    }
+
+    //! Hands a chunk over to the writer thread
+    void submit(chunk* c)
+    {
+        if (!writer.joinable())
+        {
+            out.open(FORSYDE_TRACE_FILE);
+            out << "{\"traceEvents\": [\n";
+            writer = std::thread(&trace_recorder::write_loop, this);
+        }
+        c->next = full.load(std::memory_order_relaxed);
+        while (!full.compare_exchange_weak(c->next, c, std::memory_order_release,
+                                           std::memory_order_relaxed));
+    }
+
+    //! The loop of the writer thread
+    void write_loop()
+    {
+        std::string buf;
+        while (1)
+        {
+            bool stop = stopping.load(std::memory_order_acquire);
+            chunk* list = full.exchange(NULL, std::memory_order_acquire);
+            if (list == NULL)
+            {
+                if (stop) return;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            // Restore the order of submission
+            chunk* ordered = NULL;
+            while (list != NULL)
+            {
+                chunk* next = list->next;
+                list->next = ordered;
+                ordered = list;
+                list = next;
+            }
+            while (ordered != NULL)
+            {
+                chunk* next = ordered->next;
+                buf.clear();
+                write_chunk(*ordered, buf);
+                out.write(buf.data(), buf.size());
+                delete ordered;
+                ordered = next;
+            }
+        }
+    }
+
+    //! Formats the events of a chunk
+    /*! Each firing is written as three complete events, one per stage.
+     */
+    void write_chunk(const chunk& c, std::string& buf)
+    {
+        static const char* stages[] = {"prep", "exec", "prod"};
+        for (size_t i=0; i<c.size; i++)
+        {
+            const trace_event& ev = c.events[i];
+            if (ev.kind == trace_event::FIRING)
+                for (int st=0; st<3; st++)
+                {
+                    separate(buf);
+                    buf += "{\"name\": \""; buf += stages[st];
+                    buf += "\", \"ph\": \"X\", \"pid\": 1, \"tid\": ";
+                    append_int(buf, ev.track);
+                    buf += ", \"ts\": "; append_micros(buf, ev.times[st]);
+                    buf += ", \"dur\": "; append_micros(buf, ev.times[st+1]-ev.times[st]);
+                    append_args(buf, ev);
+                }
+            else
+            {
+                separate(buf);
+                buf += "{\"name\": \""; buf += tracks[ev.track].name;
+                buf += "\", \"ph\": \"C\", \"pid\": 2, \"ts\": ";
+                append_micros(buf, ev.times[0]);
+                buf += ", \"args\": {\"tokens\": ";
+                append_int(buf, ev.times[1]);
+                buf += "}}";
+            }
+        }
+    }
+
+    //! Separates the events in the list
+    void separate(std::string& buf)
+    {
+        if (!first_event) buf += ",\n";
+        first_event = false;
+    }
+
+    //! Appends the simulated time and the delta cycle of an event
+    static void append_args(std::string& buf, const trace_event& ev)
+    {
+        char num[32];
+        buf += ", \"args\": {\"sim_time\": ";
+        buf.append(num, snprintf(num, sizeof(num), "%.12g", ev.sim_time));
+        buf += ", \"delta\": ";
+        append_int(buf, ev.delta);
+        buf += "}}";
+    }
+
+    //! Appends an integer
+    template <typename I>
+    static void append_int(std::string& buf, I val)
+    {
+        char num[24];
+        buf.append(num, std::to_chars(num, num+sizeof(num), val).ptr - num);
+    }
+
+    //! Appends a host time in nanoseconds as microseconds
+    static void append_micros(std::string& buf, int64_t ns)
+    {
+        append_int(buf, ns / 1000);
+        char frac[4] = {'.', char('0' + ns/100%10), char('0' + ns/10%10), char('0' + ns%10)};
+        buf.append(frac, 4);
+    }
+
+    //! Flushes the pending events and writes the names of the tracks
+    void close()
+    {
+        if (closed) return;
+        closed = true;
+        for (thread_slot* s = slots.load(std::memory_order_acquire); s != NULL; s = s->next)
+            if (s->current != NULL)
+            {
+                submit(s->current);
+                s->current = NULL;
+            }
+        if (!writer.joinable()) return;
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        out << ",\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1"
+            << ", \"args\": {\"name\": \"processes\"}}"
+            << ",\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 2"
+            << ", \"args\": {\"name\": \"signals\"}}";
+        for (size_t i=0; i<tracks.size(); i++)
+            if (tracks[i].is_process)
+                out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1"
+                    << ", \"tid\": " << i
+                    << ", \"args\": {\"name\": \"" << tracks[i].name << "\"}}";
+        out << "\n]}\n";
+        out.close();
+    }
+};
+
+//! The firing of a process which is being recorded
+struct trace_firing
+{
+    int64_t times[4];
+    uint64_t delta;
+    double sim_time;
+
+    //! Marks the start of a stage, which also ends the previous one
+    void start(int stage)
+    {
+        times[stage] = trace_recorder::instance().now();
+        if (stage == 0)
+        {
+            delta = sc_delta_count();
+            sim_time = sc_time_stamp().to_seconds();
+        }
+    }
+
+    //! Marks the end of the prod stage and records the firing
+    void finish(uint32_t track)
+    {
+        times[3] = trace_recorder::instance().now();
+        trace_recorder::instance().firing(track, times, delta, sim_time);
+    }
+};
+
+//! Records the occupancy of a signal after an access to it
+template <typename C>
+class trace_occupancy
+{
+public:
+    trace_occupancy(const C* ch, uint32_t track) : ch(ch), track(track) {}
+
+    ~trace_occupancy()
+    {
+        trace_recorder::instance().counter(track, ch->num_available());
+    }
+
+private:
+    const C* ch;
+    uint32_t track;
+};
+
+}
+
+#define FORSYDE_TRACE_OCCUPANCY() \
+    ForSyDe::trace_occupancy<std::remove_pointer_t<decltype(this)>> \
+        forsyde_trace_occupancy(this, trace_track)
+
+#else
+
+#define FORSYDE_TRACE_OCCUPANCY()
+
+#endif
+
+#endif
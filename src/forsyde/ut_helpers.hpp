@@ -57,6 +57,31 @@ inline comb<T0,T1>* make_comb(const std::string& pName,    ///< process name
     return p;
 }
 
+//! Helper function to construct a comb process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class F>
+inline comb<T0,T1,std::decay_t<F>>* make_comb_inline(const std::string& pName,    ///< process name
+    F&& _func,                                             ///< function to be passed
+    const unsigned int& i1toks,                            ///< consumption rate for the first input
+    OIf<T0>& outS,                                   ///< the first output signal
+    I1If<T1>& inp1S                                  ///< the first input signal
+    )
+{
+    auto p = new comb<T0,T1,std::decay_t<F>>(pName.c_str(), _func, i1toks);
+    
+    (*p).iport1(inp1S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb2 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -86,6 +111,36 @@ inline comb2<T0,T1,T2>* make_comb2(const std::string pName,///< process name
     return p;
 }
 
+//! Helper function to construct a comb2 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class F>
+inline comb2<T0,T1,T2,std::decay_t<F>>* make_comb2_inline(const std::string pName,///< process name
+    F&& _func,                                             ///< function to be passed
+    const unsigned int& i1toks,                            ///< consumption rate for the first input
+    const unsigned int& i2toks,                            ///< consumption rate for the second input
+    OIf<T0>& outS,                                   ///< the first output signal
+    I1If<T1>& inp1S,                                 ///< the first input signal
+    I2If<T2>& inp2S                                  ///< the second input signal
+    )
+{
+    auto p = new comb2<T0,T1,T2,std::decay_t<F>>(pName.c_str(), _func, 
+                                  i1toks, i2toks);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb3 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -119,6 +174,40 @@ inline comb3<T0,T1,T2,T3>* make_comb3(const std::string& pName,///< process name
     return p;
 }
 
+//! Helper function to construct a comb3 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class T3, template <class> class I3If,
+          class F>
+inline comb3<T0,T1,T2,T3,std::decay_t<F>>* make_comb3_inline(const std::string& pName,///< process name
+    F&& _func,                                             ///< function to be passed
+    const unsigned int& i1toks,                            ///< consumption rate for the first input
+    const unsigned int& i2toks,                            ///< consumption rate for the second input
+    const unsigned int& i3toks,                            ///< consumption rate for the third input
+    OIf<T0>& outS,                                   ///< the first output signal
+    I1If<T1>& inp1S,                                 ///< the first input signal
+    I2If<T2>& inp2S,                                 ///< the second input signal
+    I3If<T3>& inp3S                                  ///< the third input signal
+    )
+{
+    auto p = new comb3<T0,T1,T2,T3,std::decay_t<F>>(pName.c_str(), _func,
+                                     i1toks, i2toks, i3toks);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).iport3(inp3S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a comb4 process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
@@ -156,6 +245,44 @@ inline comb4<T0,T1,T2,T3,T4>* make_comb4(const std::string& pName,///< process n
     return p;
 }
 
+//! Helper function to construct a comb4 process with an inlined function
+/*! Similar to the above, but the function is kept with its own type
+ * (e.g., a lambda or a function object) instead of being wrapped in a
+ * std::function, so that the compiler can inline it into the process.
+ * The type of the function becomes a template parameter of the returned
+ * process.
+ */
+template <class T0, template <class> class OIf,
+          class T1, template <class> class I1If,
+          class T2, template <class> class I2If,
+          class T3, template <class> class I3If,
+          class T4, template <class> class I4If,
+          class F>
+inline comb4<T0,T1,T2,T3,T4,std::decay_t<F>>* make_comb4_inline(const std::string& pName,///< process name
+    F&& _func,                                             ///< function to be passed
+    const unsigned int& i1toks,                            ///< consumption rate for the first input
+    const unsigned int& i2toks,                            ///< consumption rate for the second input
+    const unsigned int& i3toks,                            ///< consumption rate for the third input
+    const unsigned int& i4toks,                            ///< consumption rate for the fourth input
+    OIf<T0>& outS,                                   ///< the first output signal
+    I1If<T1>& inp1S,                                 ///< the first input signal
+    I2If<T2>& inp2S,                                 ///< the second input signal
+    I3If<T3>& inp3S,                                 ///< the third input signal
+    I4If<T4>& inp4S                                  ///< the fourth input signal
+    )
+{
+    auto p = new comb4<T0,T1,T2,T3,T4,std::decay_t<F>>(pName.c_str(), _func,
+                                     i1toks, i2toks, i3toks, i4toks);
+    
+    (*p).iport1(inp1S);
+    (*p).iport2(inp2S);
+    (*p).iport3(inp3S);
+    (*p).iport4(inp4S);
+    (*p).oport1(outS);
+    
+    return p;
+}
+
 //! Helper function to construct a delay process
 /*! This function is used to construct a process (SystemC module) and
  * connect its output and output signals.
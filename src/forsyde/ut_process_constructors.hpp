@@ -40,8 +40,13 @@ using namespace sc_core;
 /*! This class is used to build combinational processes with one input
  * and one output. The class is parameterized for input and output
  * data-types.
+ * The type of the function defaults to std::function and can be set
+ * to any other callable type (see make_comb) to let the compiler inline
+ * it into the process.
  */
-template <typename T0, typename T1>
+template <typename T0, typename T1,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&)>>
 class comb : public ut_process
 {
 public:
@@ -49,9 +54,7 @@ public:
     UT_out<T0> oport1;       ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name ad the number of tokens to be produced
     /*! It creates an SC_THREAD which reads data from its input port,
@@ -94,8 +97,7 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(i1vals);
     }
     
     void exec()
@@ -105,7 +107,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
     }
     
@@ -125,7 +127,10 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2>
+template <typename T0, typename T1, typename T2,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&)>>
 class comb2 : public ut_process
 {
 public:
@@ -134,10 +139,7 @@ public:
     UT_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -183,10 +185,8 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
     }
     
     void exec()
@@ -196,7 +196,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
     }
     
@@ -217,7 +217,11 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2, typename T3>
+template <typename T0, typename T1, typename T2, typename T3,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&,
+                                                 const std::vector<T3>&)>>
 class comb3 : public ut_process
 {
 public:
@@ -227,11 +231,7 @@ public:
     UT_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&,
-                                const std::vector<T3>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -282,12 +282,9 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
-        for (auto it=i3vals.begin();it!=i3vals.end();it++)
-            *it = iport3.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
+        iport3.read_n(i3vals);
     }
     
     void exec()
@@ -297,7 +294,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
     }
     
@@ -319,7 +316,12 @@ private:
 //! Process constructor for a combinational process with two inputs and one output
 /*! similar to comb with two inputs
  */
-template <typename T0, typename T1, typename T2, typename T3, typename T4>
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+          typename FuncType = std::function<void(std::vector<T0>&,
+                                                 const std::vector<T1>&,
+                                                 const std::vector<T2>&,
+                                                 const std::vector<T3>&,
+                                                 const std::vector<T4>&)>>
 class comb4 : public ut_process
 {
 public:
@@ -330,12 +332,7 @@ public:
     UT_out<T0> oport1;        ///< port for the output channel
     
     //! Type of the function to be passed to the process constructor
-    typedef std::function<void(std::vector<T0>&,
-                                const std::vector<T1>&,
-                                const std::vector<T2>&,
-                                const std::vector<T3>&,
-                                const std::vector<T4>&
-                                )> functype;
+    typedef FuncType functype;
 
     //! The constructor requires the module name
     /*! It creates an SC_THREAD which reads data from its input ports,
@@ -391,14 +388,10 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
-        for (auto it=i3vals.begin();it!=i3vals.end();it++)
-            *it = iport3.read();
-        for (auto it=i4vals.begin();it!=i4vals.end();it++)
-            *it = iport4.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
+        iport3.read_n(i3vals);
+        iport4.read_n(i4vals);
     }
     
     void exec()
@@ -408,7 +401,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, o1vals);
+        oport1.move_n(o1vals);
         o1vals.clear();
     }
     
@@ -488,7 +481,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -568,7 +561,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        write_multiport(oport1, std::move(*val));
     }
     
     void clean()
@@ -657,8 +650,7 @@ private:
         unsigned int itoks;
         _gamma_func(itoks, *stval);    // determine how many tokens to read
         ivals.resize(itoks);
-        for (auto it=ivals.begin();it!=ivals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(ivals);
     }
     
     void exec()
@@ -765,8 +757,7 @@ private:
             unsigned int itoks;
             _gamma_func(itoks, *stval);    // determine how many tokens to read
             ivals.resize(itoks);
-            for (auto it=ivals.begin();it!=ivals.end();it++)
-                *it = iport1.read();
+            iport1.read_n(ivals);
         }
     }
     
@@ -888,8 +879,7 @@ private:
             unsigned int itoks;
             _gamma_func(itoks, *stval);    // determine how many tokens to read
             ivals.resize(itoks);
-            for (auto it=ivals.begin();it!=ivals.end();it++)
-                *it = iport1.read();
+            iport1.read_n(ivals);
         }
     }
     
@@ -911,7 +901,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, ovals);
+        oport1.move_n(ovals);
         ovals.clear();
     }
     
@@ -1031,12 +1021,7 @@ private:
             // Read the input tokens
             std::apply([&](auto&... inport) {
                 std::apply([&](auto&... ival) {
-                    (
-                        [&ival,&inport](){
-                            for (auto it=ival.begin();it!=ival.end();it++)
-                                *it = inport.read();
-                        }()
-                    , ...);
+                    (inport.read_n(ival), ...);
                 }, *ivals);
             }, iport);
         }
@@ -1061,7 +1046,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
                 (val.clear(), ...);
             }, *ovals);
         }, oport);
@@ -1176,8 +1161,7 @@ private:
         unsigned int itoks;
         _gamma_func(itoks, *stval);    // determine how many tokens to read
         ivals.resize(itoks);
-        for (auto it=ivals.begin();it!=ivals.end();it++)
-            *it = iport1.read();
+        iport1.read_n(ivals);
     }
     
     void exec()
@@ -1189,7 +1173,7 @@ private:
     
     void prod()
     {
-        write_vec_multiport(oport1, ovals);
+        oport1.move_n(ovals);
         ovals.clear();
     }
     
@@ -1304,12 +1288,7 @@ private:
         // Read the input tokens
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, *ivals);
         }, iport);
     }
@@ -1325,7 +1304,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
                 (val.clear(), ...);
             }, *ovals);
         }, oport);
@@ -1407,7 +1386,7 @@ private:
     //Implementing the abstract semantics
     void init()
     {
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 0;
     }
     
@@ -1490,7 +1469,7 @@ private:
         cur_st = new T;
         *cur_st = init_st;
         write_multiport(oport1, *cur_st);
-        if (take==0) infinite = true;
+        infinite = take==0;
         tok_cnt = 1;
     }
     
@@ -1670,10 +1649,8 @@ private:
     
     void prep()
     {
-        for (auto it=i1vals.begin();it!=i1vals.end();it++)
-            *it = iport1.read();
-        for (auto it=i2vals.begin();it!=i2vals.end();it++)
-            *it = iport2.read();
+        iport1.read_n(i1vals);
+        iport2.read_n(i2vals);
     }
     
     void exec() {}
@@ -1743,12 +1720,7 @@ private:
     {
         std::apply([&](auto&... inport) {
             std::apply([&](auto&... ival) {
-                (
-                    [&ival,&inport](){
-                        for (auto it=ival.begin();it!=ival.end();it++)
-                            *it = inport.read();
-                    }()
-                , ...);
+                (inport.read_n(ival), ...);
             }, *in_val);
         }, iport);
     }
@@ -1757,7 +1729,7 @@ private:
     
     void prod()
     {
-        write_multiport(oport1,*in_val);    // write to the output;
+        write_multiport(oport1,std::move(*in_val));    // write to the output;
     }
     
     void clean()
@@ -1824,8 +1796,8 @@ private:
     void prod()
     {
         
-        write_vec_multiport(oport1,std::get<0>(*in_val));  // write to the output 1
-        write_vec_multiport(oport2,std::get<1>(*in_val));  // write to the output 2
+        oport1.move_n(std::get<0>(*in_val));  // write to the output 1
+        oport2.move_n(std::get<1>(*in_val));  // write to the output 2
     }
     
     void clean()
@@ -1884,7 +1856,7 @@ private:
     {
         std::apply([&](auto&&... port){
             std::apply([&](auto&&... val){
-                (write_vec_multiport(port, val), ...);
+                (port.move_n(val), ...);
             }, *in_val);
         }, oport);
     }
@@ -1941,30 +1913,27 @@ public:
     std::string forsyde_kind() const {return "UT::fanout";}
     
 private:
-    // Inputs and output variables
-    T* val;
+    // Inputs and output variables (shared with the readers of broadcast channels)
+    std::shared_ptr<const T> val;
     
     //Implementing the abstract semantics
-    void init()
-    {
-        val = new T;
-    }
+    void init() {}
     
     void prep()
     {
-        *val = iport1.read();
+        val = iport1.read_shared();
     }
     
     void exec() {}
     
     void prod()
     {
-        write_multiport(oport1, *val);
+        oport1.write_shared(val);
     }
     
     void clean()
     {
-        delete val;
+        val.reset();
     }
 #ifdef FORSYDE_INTROSPECTION
     void bindInfo()